@@ -0,0 +1,249 @@
+#ifndef COSMOGENIC_AFTER_MUON_VETO_H
+#define COSMOGENIC_AFTER_MUON_VETO_H
+
+#include <deque>
+#include <limits>
+#include <iomanip>
+#include <stdexcept>
+#include <regex>
+#include "Cosmogenic/Veto.hpp"
+#include "Cosmogenic/Muon.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class AfterMuonVeto : public Veto<T>{//vetoes the singles following a muon, for longer if the muon showered (the muons and the vetoed events must be given in time order)
+    
+    struct MuonRecord{
+      
+      TriggerTime triggerTime;
+      TriggerTime vetoEndTime;//of this muon and all the previous ones
+
+    };
+
+    TriggerTime muonVetoTime;
+    TriggerTime showeringMuonVetoTime;
+    T showeringEnergyThreshold;//visible energy
+    T showeringChargeThreshold;//inner detector charge
+    T showeringEnergyDensityThreshold;//visible energy per unit track length in the detector
+    std::deque<MuonRecord> muonRecords;
+    TriggerTime erasedVetoEndTime;//of the muons erased from the records
+    TriggerTime getVetoEndTime(TriggerTime triggerTime) const;//O(1) at or after the last muon, O(log n) before
+
+  public:
+    AfterMuonVeto();
+    AfterMuonVeto(TriggerTime muonVetoTime, TriggerTime showeringMuonVetoTime, T showeringEnergyThreshold, T showeringChargeThreshold, T showeringEnergyDensityThreshold);
+    TriggerTime getMuonVetoTime() const;
+    TriggerTime getShoweringMuonVetoTime() const;
+    T getShoweringEnergyThreshold() const;
+    T getShoweringChargeThreshold() const;
+    T getShoweringEnergyDensityThreshold() const;
+    bool isShowering(const Muon<T>& muon) const;
+    TriggerTime getVetoDuration(const Muon<T>& muon) const;//e.g. for a LivetimeCalculator
+    TriggerTime getVetoActiveUntil() const;//end of the veto of all the muons added so far
+    void addMuon(const Muon<T>& muon);
+    void eraseBefore(TriggerTime triggerTime);//forget the muons older than 'triggerTime', later events must not be older
+    void clear() override;//e.g. between runs
+    bool veto(TriggerTime triggerTime) const;
+    bool veto(const Single<T>& single) const;
+    bool veto(const CandidatePair<T>& candidatePair) const;//prompt or delayed after a muon
+    std::unique_ptr<Veto<T>> clone() const;
+    void print(std::ostream& output) const;
+
+  };
+
+  template <class T>
+  TriggerTime AfterMuonVeto<T>::getVetoEndTime(TriggerTime triggerTime) const{
+    
+    if(muonRecords.empty() || triggerTime >= muonRecords.back().triggerTime) return muonRecords.empty() ? erasedVetoEndTime : muonRecords.back().vetoEndTime;
+
+    auto itNext = std::upper_bound(muonRecords.begin(), muonRecords.end(), triggerTime, [](TriggerTime time, const auto& muonRecord){return time < muonRecord.triggerTime;});
+    if(itNext == muonRecords.begin()) return erasedVetoEndTime;
+    else return std::prev(itNext)->vetoEndTime;
+
+  }
+
+  template <class T>
+  AfterMuonVeto<T>::AfterMuonVeto()
+  :AfterMuonVeto<T>(0, 0, std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()){
+  
+  }
+
+  template <class T>
+  AfterMuonVeto<T>::AfterMuonVeto(TriggerTime muonVetoTime, TriggerTime showeringMuonVetoTime, T showeringEnergyThreshold, T showeringChargeThreshold, T showeringEnergyDensityThreshold)
+  :Veto<T>("AfterMuonVeto"),muonVetoTime(muonVetoTime),showeringMuonVetoTime(showeringMuonVetoTime),showeringEnergyThreshold(showeringEnergyThreshold),showeringChargeThreshold(showeringChargeThreshold),showeringEnergyDensityThreshold(showeringEnergyDensityThreshold),erasedVetoEndTime(std::numeric_limits<TriggerTime>::lowest()){
+    
+    if(muonVetoTime < 0 || showeringMuonVetoTime < 0 || showeringEnergyThreshold < 0 || showeringChargeThreshold < 0 || showeringEnergyDensityThreshold < 0){
+      
+      auto errorMessage = std::to_string(muonVetoTime)+"ns, "+std::to_string(showeringMuonVetoTime)+"ns, "+std::to_string(showeringEnergyThreshold)+"MeV, "+std::to_string(showeringChargeThreshold)+"DUQ and "+std::to_string(showeringEnergyDensityThreshold)+"MeV/mm are invalid after muon veto parameters.";
+      throw std::invalid_argument(errorMessage);
+
+    }
+
+  }
+
+  template <class T>
+  TriggerTime AfterMuonVeto<T>::getMuonVetoTime() const{
+    
+    return muonVetoTime;
+
+  }
+
+  template <class T>
+  TriggerTime AfterMuonVeto<T>::getShoweringMuonVetoTime() const{
+    
+    return showeringMuonVetoTime;
+
+  }
+
+  template <class T>
+  T AfterMuonVeto<T>::getShoweringEnergyThreshold() const{
+    
+    return showeringEnergyThreshold;
+
+  }
+
+  template <class T>
+  T AfterMuonVeto<T>::getShoweringChargeThreshold() const{
+    
+    return showeringChargeThreshold;
+
+  }
+
+  template <class T>
+  T AfterMuonVeto<T>::getShoweringEnergyDensityThreshold() const{
+    
+    return showeringEnergyDensityThreshold;
+
+  }
+
+  template <class T>
+  bool AfterMuonVeto<T>::isShowering(const Muon<T>& muon) const{
+    
+    auto visibleEnergy = muon.template Event<T>::getVisibleEnergy();
+    if(visibleEnergy >= showeringEnergyThreshold || muon.getDetectorCharge() >= showeringChargeThreshold) return true;
+
+    auto trackLenght = muon.getTrack().getLenght();
+    return trackLenght > 0 && visibleEnergy >= showeringEnergyDensityThreshold * trackLenght;//more light than a minimum ionising crossing
+
+  }
+
+  template <class T>
+  TriggerTime AfterMuonVeto<T>::getVetoDuration(const Muon<T>& muon) const{
+    
+    return isShowering(muon) ? std::max(muonVetoTime, showeringMuonVetoTime) : muonVetoTime;
+
+  }
+
+  template <class T>
+  TriggerTime AfterMuonVeto<T>::getVetoActiveUntil() const{
+    
+    return muonRecords.empty() ? erasedVetoEndTime : muonRecords.back().vetoEndTime;
+
+  }
+
+  template <class T>
+  void AfterMuonVeto<T>::addMuon(const Muon<T>& muon){
+    
+    auto triggerTime = muon.getTriggerTime();
+    if(!muonRecords.empty() && triggerTime < muonRecords.back().triggerTime) throw std::invalid_argument("Muon "+std::to_string(muon.getIdentifier())+" at "+std::to_string(triggerTime)+"ns breaks the time ordering of the after muon veto.");
+
+    muonRecords.push_back(MuonRecord{triggerTime, std::max(getVetoActiveUntil(), triggerTime + getVetoDuration(muon))});
+
+  }
+
+  template <class T>
+  void AfterMuonVeto<T>::eraseBefore(TriggerTime triggerTime){
+    
+    while(!muonRecords.empty() && muonRecords.front().triggerTime < triggerTime){
+      
+      erasedVetoEndTime = muonRecords.front().vetoEndTime;
+      muonRecords.pop_front();
+
+    }
+
+  }
+
+  template <class T>
+  void AfterMuonVeto<T>::clear(){
+    
+    muonRecords.clear();
+    erasedVetoEndTime = std::numeric_limits<TriggerTime>::lowest();
+
+  }
+
+  template <class T>
+  bool AfterMuonVeto<T>::veto(TriggerTime triggerTime) const{
+    
+    return triggerTime < getVetoEndTime(triggerTime);
+
+  }
+
+  template <class T>
+  bool AfterMuonVeto<T>::veto(const Single<T>& single) const{
+    
+    return veto(single.getTriggerTime());
+
+  }
+
+  template <class T>
+  bool AfterMuonVeto<T>::veto(const CandidatePair<T>& candidatePair) const{
+    
+    return veto(candidatePair.getPrompt()) || veto(candidatePair.getDelayed());
+
+  }
+
+  template <class T>
+  std::unique_ptr<Veto<T>> AfterMuonVeto<T>::clone() const{
+    
+    return std::make_unique<AfterMuonVeto<T>>(*this);
+
+  }
+
+  template <class T>
+  void AfterMuonVeto<T>::print(std::ostream& output) const{
+    
+    int labelColumnWidth = 26;
+    int dataColumnWidth = 10;
+
+    Veto<T>::print(output);
+    output<<"\n"<<std::setw(labelColumnWidth)<<std::left<<"Muon veto time"<<": "<<std::setw(dataColumnWidth)<<std::right<<muonVetoTime<<"\n"
+      <<std::setw(labelColumnWidth)<<std::left<<"Showering muon veto time"<<": "<<std::setw(dataColumnWidth)<<std::right<<showeringMuonVetoTime<<"\n"
+      <<std::setw(labelColumnWidth)<<std::left<<"Showering energy"<<": "<<std::setw(dataColumnWidth)<<std::right<<showeringEnergyThreshold<<"\n"
+      <<std::setw(labelColumnWidth)<<std::left<<"Showering charge"<<": "<<std::setw(dataColumnWidth)<<std::right<<showeringChargeThreshold<<"\n"
+      <<std::setw(labelColumnWidth)<<std::left<<"Showering energy density"<<": "<<std::setw(dataColumnWidth)<<std::right<<showeringEnergyDensityThreshold;
+
+  }
+
+  template <class T>
+  std::ostream& operator<<(std::ostream& output, const AfterMuonVeto<T>& afterMuonVeto){
+    
+    afterMuonVeto.print(output);
+    return output;
+
+  }
+
+  template <class T>
+  std::istream& operator>>(std::istream& input, AfterMuonVeto<T>& afterMuonVeto){
+    
+    std::string token;
+    input >> token;
+
+    std::string number("[+-]?(?:\\d*\\.)?\\d+(?:[eE][-+]?[0-9]+)?");//decimal number with possible sign and exponent
+    std::string regexString = "^(";
+    for(unsigned k = 0; k < 4; ++k) regexString += number+")[:,](";//start with a number :, seprator
+    regexString += number+")$";
+
+    std::regex regex(regexString);
+    std::smatch regexMatches;
+    if(std::regex_search(token, regexMatches, regex))
+      afterMuonVeto = std::move(AfterMuonVeto<T>(std::stod(regexMatches[1]), std::stod(regexMatches[2]), std::stod(regexMatches[3]), std::stod(regexMatches[4]), std::stod(regexMatches[5])));
+    else throw std::invalid_argument(token+" cannot be parsed to build an after muon veto.");
+
+    return input;
+
+  }
+
+}
+
+#endif
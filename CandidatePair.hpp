@@ -12,16 +12,19 @@ namespace CosmogenicHunter{
     Single<T> delayed;
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned, see ClassVersion.hpp
     CandidatePair() = default;
     CandidatePair(Single<T> prompt, Single<T> delayed);
     const Single<T>& getPrompt() const;
     const Single<T>& getDelayed() const;
-    double getTimeCorrelation() const;
+    TriggerTime getTimeCorrelation() const;
     T getSpaceCorrelation() const;
-    bool isTimeCorrelated(const Bounds<double>& timeBounds) const;
+    bool isTimeCorrelated(const Bounds<TriggerTime>& timeBounds) const;
     bool isSpaceCorrelated(T maxDistance) const;
     bool isLightNoise(const LightNoiseVeto<T>& lightNoiseVeto) const;
     bool isPoorlyReconstructed(const ReconstructionVeto<T>& reconstructionVeto) const;
@@ -35,9 +38,19 @@ namespace CosmogenicHunter{
   
   template <class T>
   template <class Archive>
-  void CandidatePair<T>::serialize(Archive& archive){
+  void CandidatePair<T>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(prompt, delayed);
+    else throw std::runtime_error(getUnknownVersionMessage<CandidatePair<T>>("CandidatePair", version));
+
+  }
+  
+  template <class T>
+  template <class Archive>
+  void CandidatePair<T>::loadUnversioned(Archive& archive){
     
-    archive(prompt, delayed);
+    prompt.loadUnversioned(archive);
+    delayed.loadUnversioned(archive);
 
   }
   
@@ -62,7 +75,7 @@ namespace CosmogenicHunter{
   }
   
   template <class T>
-  double CandidatePair<T>::getTimeCorrelation() const{
+  TriggerTime CandidatePair<T>::getTimeCorrelation() const{
 
     return delayed.getTriggerTime() - prompt.getTriggerTime();
   
@@ -76,7 +89,7 @@ namespace CosmogenicHunter{
   }
 
   template <class T>
-  bool CandidatePair<T>::isTimeCorrelated(const Bounds<double>& timeBounds) const{
+  bool CandidatePair<T>::isTimeCorrelated(const Bounds<TriggerTime>& timeBounds) const{
     
     return areTimeCorrelated(prompt, delayed, timeBounds);
 
@@ -153,5 +166,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::CandidatePair)
 
 #endif
\ No newline at end of file
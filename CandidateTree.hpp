@@ -4,6 +4,7 @@
 #include "Cosmogenic/CandidatePair.hpp"
 #include "Cosmogenic/Muon.hpp"
 #include "Cosmogenic/Shower.hpp"
+#include "Cosmogenic/SharedWindow.hpp"
 
 namespace CosmogenicHunter{
 
@@ -11,33 +12,63 @@ namespace CosmogenicHunter{
   class CandidateTree{
     
     CandidatePair<T> candidatePair;//parent of the tree
-    Window<Shower<Muon<K>, Single<T>>> muonShowers;
+    SharedWindow<Shower<Muon<K>, Single<T>>> muonShowers;//shared with the other trees built from the same muon history
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   public:
+    static constexpr std::uint32_t serializationVersion = 2;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned, see ClassVersion.hpp
+    using allocator_type = typename SharedWindow<Shower<Muon<K>, Single<T>>>::allocator_type;
     CandidateTree() = default;
-    CandidateTree(CandidatePair<T> candidatePair, Window<Shower<Muon<K>, Single<T>>> muonShowers);
+    CandidateTree(CandidatePair<T> candidatePair, SharedWindow<Shower<Muon<K>, Single<T>>> muonShowers);
+    CandidateTree(CandidatePair<T> candidatePair, const Window<Shower<Muon<K>, Single<T>>>& muonShowers, const allocator_type& allocator = {});//copies the showers (and their followers) with 'allocator', e.g. into a RunArena
     const CandidatePair<T>& getCandidatePair() const;
-    const Window<Shower<Muon<K>, Single<T>>>& getMuonShowers() const;
-    double getTimeCorrelationToLastMuon() const;
-    bool isAfterMuon(double afterMuonTimeVeto) const;
+    const SharedWindow<Shower<Muon<K>, Single<T>>>& getMuonShowers() const;
+    TriggerTime getTimeCorrelationToLastMuon() const;
+    bool isAfterMuon(TriggerTime afterMuonTimeVeto) const;
     
   };
   
   template <class T, class K>
   template <class Archive>
-  void CandidateTree<T,K>::serialize(Archive& archive){
+  void CandidateTree<T,K>::serialize(Archive& archive, std::uint32_t version){
     
-    archive(candidatePair, muonShowers);
+    if(version == serializationVersion) archive(candidatePair, muonShowers);
+    else if(version == 1){//the showers used to be stored in a Window
+      
+      Window<Shower<Muon<K>, Single<T>>> muonShowerWindow;
+      archive(candidatePair, muonShowerWindow);
+      muonShowers = SharedWindow<Shower<Muon<K>, Single<T>>>(muonShowerWindow);
+      
+    }
+    else throw std::runtime_error(getUnknownVersionMessage<CandidateTree<T,K>>("CandidateTree", version));
 
   }
   
   template <class T, class K>
-  CandidateTree<T,K>::CandidateTree(CandidatePair<T> candidatePair, Window<Shower<Muon<K>, Single<T>>> muonShowers)
+  template <class Archive>
+  void CandidateTree<T,K>::loadUnversioned(Archive& archive){
+    
+    Window<Shower<Muon<K>, Single<T>>> muonShowerWindow;//as version 1
+    candidatePair.loadUnversioned(archive);
+    muonShowerWindow.loadUnversioned(archive);
+    muonShowers = SharedWindow<Shower<Muon<K>, Single<T>>>(muonShowerWindow);
+
+  }
+  
+  template <class T, class K>
+  CandidateTree<T,K>::CandidateTree(CandidatePair<T> candidatePair, SharedWindow<Shower<Muon<K>, Single<T>>> muonShowers)
   :candidatePair(std::move(candidatePair)),muonShowers(std::move(muonShowers)){
     
+  }
+  
+  template <class T, class K>
+  CandidateTree<T,K>::CandidateTree(CandidatePair<T> candidatePair, const Window<Shower<Muon<K>, Single<T>>>& muonShowers, const allocator_type& allocator)
+  :candidatePair(std::move(candidatePair)),muonShowers(muonShowers, allocator){
+    
   }
 
   template <class T, class K>
@@ -48,21 +79,21 @@ namespace CosmogenicHunter{
   }
   
   template <class T, class K>
-  const Window<Shower<Muon<K>, Single<T>>>& CandidateTree<T,K>::getMuonShowers() const{
+  const SharedWindow<Shower<Muon<K>, Single<T>>>& CandidateTree<T,K>::getMuonShowers() const{
     
     return muonShowers;
     
   }
   
   template <class T, class K>
-  double CandidateTree<T,K>::getTimeCorrelationToLastMuon() const{
+  TriggerTime CandidateTree<T,K>::getTimeCorrelationToLastMuon() const{
     
     return CosmogenicHunter::getTimeCorrelation(candidatePair.getPrompt(), muonShowers.back().getInitiator());
     
   }
   
   template <class T, class K>
-  bool CandidateTree<T,K>::isAfterMuon(double afterMuonTimeVeto) const{
+  bool CandidateTree<T,K>::isAfterMuon(TriggerTime afterMuonTimeVeto) const{
     
     return getTimeCorrelationToLastMuon() < afterMuonTimeVeto;
     
@@ -82,5 +113,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::CandidateTree)
 
 #endif
\ No newline at end of file
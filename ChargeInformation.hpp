@@ -17,6 +17,8 @@ namespace CosmogenicHunter{
   public:
     ChargeInformation();
     ChargeInformation(T RMS, T difference, T ratio, T startTimeRMS);
+    template <class K>
+    ChargeInformation(const ChargeInformation<K>& other);//conversion between precisions
     T getRMS() const;
     T getDifference() const;
     T getRatio() const;
@@ -55,6 +57,13 @@ namespace CosmogenicHunter{
     
   }
 
+  template <class T>
+  template <class K>
+  ChargeInformation<T>::ChargeInformation(const ChargeInformation<K>& other)
+  :RMS(static_cast<T>(other.getRMS())),difference(static_cast<T>(other.getDifference())),ratio(static_cast<T>(other.getRatio())),startTimeRMS(static_cast<T>(other.getStartTimeRMS())){
+    
+  }
+
   template <class T>
   T ChargeInformation<T>::getRMS() const{
     
@@ -0,0 +1,171 @@
+#ifndef COSMOGENIC_CHECKPOINT_H
+#define COSMOGENIC_CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <future>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <filesystem>
+#include "cereal/archives/binary.hpp"
+#include "cereal/types/string.hpp"
+#include "cereal/types/utility.hpp"
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+
+namespace CosmogenicHunter{
+
+  class Checkpoint{//named snapshots of the live state of a job (e.g. an OnlineTreeBuilder, CutFlow's and stream offsets), written atomically so that a pre-empted job resumes where it was
+
+    using Section = std::pair<std::string, std::string>;//name and serialized state
+
+    std::string filePath;
+    std::vector<Section> sections;//in the order they were first saved
+    std::future<void> pendingWrite;
+    std::vector<Section>::iterator findSection(const std::string& name);
+    std::vector<Section>::const_iterator findSection(const std::string& name) const;
+    static void write(const std::string& filePath, const std::vector<Section>& sections);
+
+  public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    explicit Checkpoint(std::string filePath);//reads the sections of the previous checkpoint, if any
+    Checkpoint(const Checkpoint& other) = delete;
+    Checkpoint& operator = (const Checkpoint& other) = delete;
+    ~Checkpoint();//waits for the last commit
+    const std::string& getFilePath() const;
+    unsigned getNumberOfSections() const;
+    bool hasSection(const std::string& name) const;
+    template <class State>
+    void save(const std::string& name, const State& state);//serializes 'state' in memory, sections not saved again are committed unchanged so only the states that changed need to be saved
+    template <class State>
+    bool restore(const std::string& name, State& state) const;//false if there is no such section
+    void commit();//writes a copy of the sections on a background thread, to a temporary file renamed over the previous checkpoint once complete
+    void wait();//waits for the last commit, rethrowing its errors
+    void remove();//e.g. once the job completed
+
+  };
+
+  inline std::vector<Checkpoint::Section>::iterator Checkpoint::findSection(const std::string& name){
+    
+    return std::find_if(sections.begin(), sections.end(), [&](const auto& section){return section.first == name;});
+
+  }
+
+  inline std::vector<Checkpoint::Section>::const_iterator Checkpoint::findSection(const std::string& name) const{
+    
+    return std::find_if(sections.begin(), sections.end(), [&](const auto& section){return section.first == name;});
+
+  }
+
+  inline void Checkpoint::write(const std::string& filePath, const std::vector<Section>& sections){
+    
+    auto temporaryFilePath = filePath + ".tmp";
+    {
+      
+      std::ofstream file(temporaryFilePath, std::ios::binary | std::ios::trunc);
+      if(!file) throw std::runtime_error("Cannot open "+temporaryFilePath+" to write the checkpoint.");
+
+      cereal::BinaryOutputArchive archive(file);
+      archive(serializationVersion, sections);
+      file.flush();
+      if(!file) throw std::runtime_error("Cannot write the checkpoint to "+temporaryFilePath+".");
+
+    }
+    std::filesystem::rename(temporaryFilePath, filePath);//atomic: a job pre-empted while writing keeps the previous checkpoint
+
+  }
+
+  inline Checkpoint::Checkpoint(std::string filePath):filePath(std::move(filePath)){
+    
+    std::ifstream file(this->filePath, std::ios::binary);
+    if(file){
+      
+      cereal::BinaryInputArchive archive(file);
+      std::uint32_t version;
+      archive(version);
+      if(version != serializationVersion) throw std::runtime_error(getUnknownVersionMessage<Checkpoint>("Checkpoint", version));
+      archive(sections);
+
+    }
+
+  }
+
+  inline Checkpoint::~Checkpoint(){
+    
+    if(pendingWrite.valid()) pendingWrite.wait();
+
+  }
+
+  inline const std::string& Checkpoint::getFilePath() const{
+    
+    return filePath;
+
+  }
+
+  inline unsigned Checkpoint::getNumberOfSections() const{
+    
+    return sections.size();
+
+  }
+
+  inline bool Checkpoint::hasSection(const std::string& name) const{
+    
+    return findSection(name) != sections.end();
+
+  }
+
+  template <class State>
+  void Checkpoint::save(const std::string& name, const State& state){
+    
+    std::ostringstream stream;
+    {
+      
+      cereal::BinaryOutputArchive archive(stream);
+      archive(state);
+
+    }
+
+    auto itSection = findSection(name);
+    if(itSection != sections.end()) itSection->second = stream.str();
+    else sections.emplace_back(name, stream.str());
+
+  }
+
+  template <class State>
+  bool Checkpoint::restore(const std::string& name, State& state) const{
+    
+    auto itSection = findSection(name);
+    if(itSection == sections.end()) return false;
+
+    std::istringstream stream(itSection->second);
+    cereal::BinaryInputArchive archive(stream);
+    archive(state);
+    return true;
+
+  }
+
+  inline void Checkpoint::commit(){
+    
+    wait();//commits are written in order
+    pendingWrite = std::async(std::launch::async, [filePath = filePath, sections = sections](){write(filePath, sections);});
+
+  }
+
+  inline void Checkpoint::wait(){
+    
+    if(pendingWrite.valid()) pendingWrite.get();
+
+  }
+
+  inline void Checkpoint::remove(){
+    
+    wait();
+    sections.clear();
+    std::filesystem::remove(filePath);
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef COSMOGENIC_CLASS_VERSION_H
+#define COSMOGENIC_CLASS_VERSION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "cereal/details/helpers.hpp"
+
+//register TEMPLATE<Args...>::serializationVersion as the cereal version of every instantiation of the class template TEMPLATE
+//cereal writes the version once per type and per archive, and hands it back to 'serialize(Archive&, std::uint32_t)' when loading
+#define COSMOGENIC_CLASS_VERSION(TEMPLATE)\
+  namespace cereal{\
+    namespace detail{\
+      template <class... Args>\
+      struct Version<TEMPLATE<Args...>>{\
+        static const std::uint32_t version = TEMPLATE<Args...>::serializationVersion;\
+      };\
+    }\
+  }
+
+namespace CosmogenicHunter{
+
+  template <class Class>
+  std::string getUnknownVersionMessage(const std::string& className, std::uint32_t version){//archives written by a more recent version of the library
+
+    return "Cannot read "+className+" version "+std::to_string(version)+" (latest known version is "+std::to_string(Class::serializationVersion)+").";
+
+  }
+
+  //archives written before the classes were versioned hold the same members without any version number, so they can only be read by the 'loadUnversioned' members
+  template <class Archive, class Class>
+  void loadUnversioned(Archive& archive, Class& object){
+    
+    object.loadUnversioned(archive);
+
+  }
+
+  template <class Archive, class Class, class Allocator>
+  void loadUnversioned(Archive& archive, std::vector<Class, Allocator>& objects){//e.g. the candidate trees of a run
+    
+    cereal::size_type numberOfObjects;
+    archive(cereal::make_size_tag(numberOfObjects));
+    objects.resize(numberOfObjects);
+    for(auto& object : objects) loadUnversioned(archive, object);
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef COSMOGENIC_COSMOGENIC_LIKELIHOOD_H
+#define COSMOGENIC_COSMOGENIC_LIKELIHOOD_H
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include "Cosmogenic/TabulatedFunction.hpp"
+#include "Cosmogenic/Single.hpp"
+#include "Cosmogenic/Muon.hpp"
+#include "Cosmogenic/Shower.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class CosmogenicLikelihood{//log likelihood ratio of a single being cosmogenic rather than accidental, maximised over the preceding muons, from the distance to the muon track, the time since the muon and the muon visible energy
+    
+    TabulatedFunction<T> distanceLogRatio;//log(cosmogenic PDF / accidental PDF)
+    TabulatedFunction<T> timeLogRatio;
+    TabulatedFunction<T> energyLogRatio;
+    friend class cereal::access;
+    template <class Archive>
+    void serialize(Archive& archive, std::uint32_t version);//the log ratios only, so that the PDFs are tabulated once
+    static TabulatedFunction<T> getLogRatio(const TabulatedFunction<T>& cosmogenicPDF, const TabulatedFunction<T>& accidentalPDF);//on the nodes of the cosmogenic PDF
+
+  public:
+    struct MuonTrack{//what the likelihood needs from a muon, computed once per muon
+      
+      TriggerTime triggerTime;
+      T energyLogRatio;
+      T startX, startY, startZ;
+      T directionX, directionY, directionZ;//unit vector along the track, null for a point-like track
+
+    };
+
+    static constexpr std::uint32_t serializationVersion = 1;
+    CosmogenicLikelihood() = default;
+    CosmogenicLikelihood(const TabulatedFunction<T>& cosmogenicDistancePDF, const TabulatedFunction<T>& accidentalDistancePDF, const TabulatedFunction<T>& cosmogenicTimePDF, const TabulatedFunction<T>& accidentalTimePDF, const TabulatedFunction<T>& cosmogenicEnergyPDF, const TabulatedFunction<T>& accidentalEnergyPDF);//distances in mm, times since the muon in ns, muon visible energies in MeV
+    const TabulatedFunction<T>& getDistanceLogRatio() const;
+    const TabulatedFunction<T>& getTimeLogRatio() const;
+    const TabulatedFunction<T>& getEnergyLogRatio() const;
+    T getMinLogLikelihood() const;//of a single without any correlated muon
+    bool isTimeCorrelated(TriggerTime timeSinceMuon) const;//muons outside the range of the time PDF's are ignored
+    template <class K>
+    MuonTrack getMuonTrack(const Muon<K>& muon) const;
+    T getLogLikelihood(const MuonTrack& muonTrack, T x, T y, T z, TriggerTime triggerTime) const;
+    template <class Payload, class K>
+    T getLogLikelihood(const Single<T, Payload>& single, const Muon<K>& muon) const;
+    template <class Payload, class Muons>
+    T getLogLikelihood(const Single<T, Payload>& single, const Muons& muons) const;//'muons' holds Muon's or muon Shower's, e.g. the muon shower window of a candidate tree
+    template <class Payload, class Muons>
+    void fill(Single<T, Payload>& single, const Muons& muons) const;//sets the cosmogenic likelihood of 'single'
+    template <class K, class Singles>
+    void fill(const Muon<K>& muon, Singles& singles) const;//raises the cosmogenic likelihood of each single to the one from 'muon' if larger, the singles must have been reset to 'getMinLogLikelihood()'
+    void fill(const MuonTrack& muonTrack, std::size_t numberOfSingles, const T* xs, const T* ys, const T* zs, const TriggerTime* triggerTimes, T* logLikelihoods) const;//columnar version of the previous one, branchless so that compilers vectorise it
+
+  };
+
+  template <class T>
+  template <class Archive>
+  void CosmogenicLikelihood<T>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(distanceLogRatio, timeLogRatio, energyLogRatio);
+    else throw std::runtime_error(getUnknownVersionMessage<CosmogenicLikelihood<T>>("CosmogenicLikelihood", version));
+
+  }
+
+  template <class T>
+  TabulatedFunction<T> CosmogenicLikelihood<T>::getLogRatio(const TabulatedFunction<T>& cosmogenicPDF, const TabulatedFunction<T>& accidentalPDF){
+    
+    auto cosmogenicFloor = cosmogenicPDF.getMaxValue() * std::numeric_limits<T>::epsilon();//keeps the ratio finite where a PDF vanishes
+    auto accidentalFloor = accidentalPDF.getMaxValue() * std::numeric_limits<T>::epsilon();
+    if(!(cosmogenicFloor > 0) || !(accidentalFloor > 0)) throw std::invalid_argument("Cannot build a cosmogenic likelihood from a null PDF.");
+
+    return TabulatedFunction<T>(cosmogenicPDF.getLowEdge(), cosmogenicPDF.getUpEdge(), cosmogenicPDF.getNumberOfNodes(), [&](T x){return std::log(std::max(cosmogenicPDF(x), cosmogenicFloor)) - std::log(std::max(accidentalPDF(x), accidentalFloor));});
+
+  }
+
+  template <class T>
+  CosmogenicLikelihood<T>::CosmogenicLikelihood(const TabulatedFunction<T>& cosmogenicDistancePDF, const TabulatedFunction<T>& accidentalDistancePDF, const TabulatedFunction<T>& cosmogenicTimePDF, const TabulatedFunction<T>& accidentalTimePDF, const TabulatedFunction<T>& cosmogenicEnergyPDF, const TabulatedFunction<T>& accidentalEnergyPDF)
+  :distanceLogRatio(getLogRatio(cosmogenicDistancePDF, accidentalDistancePDF)),timeLogRatio(getLogRatio(cosmogenicTimePDF, accidentalTimePDF)),energyLogRatio(getLogRatio(cosmogenicEnergyPDF, accidentalEnergyPDF)){
+    
+    if(cosmogenicTimePDF.getLowEdge() < 0) throw std::invalid_argument(std::to_string(cosmogenicTimePDF.getLowEdge())+"ns is not a valid lower edge for the time since the muon.");
+
+  }
+
+  template <class T>
+  const TabulatedFunction<T>& CosmogenicLikelihood<T>::getDistanceLogRatio() const{
+    
+    return distanceLogRatio;
+
+  }
+
+  template <class T>
+  const TabulatedFunction<T>& CosmogenicLikelihood<T>::getTimeLogRatio() const{
+    
+    return timeLogRatio;
+
+  }
+
+  template <class T>
+  const TabulatedFunction<T>& CosmogenicLikelihood<T>::getEnergyLogRatio() const{
+    
+    return energyLogRatio;
+
+  }
+
+  template <class T>
+  T CosmogenicLikelihood<T>::getMinLogLikelihood() const{
+    
+    return distanceLogRatio.getMinValue() + timeLogRatio.getMinValue() + energyLogRatio.getMinValue();
+
+  }
+
+  template <class T>
+  bool CosmogenicLikelihood<T>::isTimeCorrelated(TriggerTime timeSinceMuon) const{
+    
+    return timeSinceMuon >= timeLogRatio.getLowEdge() && timeSinceMuon <= timeLogRatio.getUpEdge();
+
+  }
+
+  template <class T>
+  template <class K>
+  typename CosmogenicLikelihood<T>::MuonTrack CosmogenicLikelihood<T>::getMuonTrack(const Muon<K>& muon) const{
+    
+    const auto& startPoint = muon.getTrack().getStartPoint();
+    const auto& endPoint = muon.getTrack().getEndPoint();
+    T lenght = muon.getTrack().getLenght();
+    T inverseLenght = lenght > 0 ? 1 / lenght : 0;
+
+    return MuonTrack{muon.getTriggerTime(), energyLogRatio(muon.template Event<K>::getVisibleEnergy()), T(startPoint.getX()), T(startPoint.getY()), T(startPoint.getZ()), T(endPoint.getX() - startPoint.getX()) * inverseLenght, T(endPoint.getY() - startPoint.getY()) * inverseLenght, T(endPoint.getZ() - startPoint.getZ()) * inverseLenght};
+
+  }
+
+  template <class T>
+  T CosmogenicLikelihood<T>::getLogLikelihood(const MuonTrack& muonTrack, T x, T y, T z, TriggerTime triggerTime) const{
+    
+    auto timeSinceMuon = triggerTime - muonTrack.triggerTime;
+    if(!isTimeCorrelated(timeSinceMuon)) return getMinLogLikelihood();
+
+    auto distance = getDistanceToLine(x - muonTrack.startX, y - muonTrack.startY, z - muonTrack.startZ, muonTrack.directionX, muonTrack.directionY, muonTrack.directionZ);//to the line of the track
+
+    return distanceLogRatio(distance) + timeLogRatio(static_cast<T>(timeSinceMuon)) + muonTrack.energyLogRatio;
+
+  }
+
+  template <class T>
+  template <class Payload, class K>
+  T CosmogenicLikelihood<T>::getLogLikelihood(const Single<T, Payload>& single, const Muon<K>& muon) const{
+    
+    const auto& position = single.getPositionInformation().getPosition();
+    return getLogLikelihood(getMuonTrack(muon), position.getX(), position.getY(), position.getZ(), single.getTriggerTime());
+
+  }
+
+  template <class T>
+  template <class Payload, class Muons>
+  T CosmogenicLikelihood<T>::getLogLikelihood(const Single<T, Payload>& single, const Muons& muons) const{
+    
+    auto logLikelihood = getMinLogLikelihood();
+    for(const auto& muon : muons){
+      
+      if(isTimeCorrelated(single.getTriggerTime() - muon.getTriggerTime())) logLikelihood = std::max(logLikelihood, getLogLikelihood(single, getMuon(muon)));
+
+    }
+
+    return logLikelihood;
+
+  }
+
+  template <class T>
+  template <class Payload, class Muons>
+  void CosmogenicLikelihood<T>::fill(Single<T, Payload>& single, const Muons& muons) const{
+    
+    single.setCosmogenicLikelihood(getLogLikelihood(single, muons));
+
+  }
+
+  template <class T>
+  template <class K, class Singles>
+  void CosmogenicLikelihood<T>::fill(const Muon<K>& muon, Singles& singles) const{
+    
+    auto muonTrack = getMuonTrack(muon);
+    for(auto& single : singles){
+      
+      const auto& position = single.getPositionInformation().getPosition();
+      auto logLikelihood = getLogLikelihood(muonTrack, position.getX(), position.getY(), position.getZ(), single.getTriggerTime());
+      if(logLikelihood > single.getCosmogenicLikelihood()) single.setCosmogenicLikelihood(logLikelihood);
+
+    }
+
+  }
+
+  template <class T>
+  void CosmogenicLikelihood<T>::fill(const MuonTrack& muonTrack, std::size_t numberOfSingles, const T* xs, const T* ys, const T* zs, const TriggerTime* triggerTimes, T* logLikelihoods) const{
+    
+    auto muonTriggerTime = muonTrack.triggerTime;//local copies: the outputs may alias the members, which would forbid vectorisation
+    auto startX = muonTrack.startX, startY = muonTrack.startY, startZ = muonTrack.startZ;
+    auto directionX = muonTrack.directionX, directionY = muonTrack.directionY, directionZ = muonTrack.directionZ;
+    auto energyLogLikelihood = muonTrack.energyLogRatio;
+    auto minLogLikelihood = getMinLogLikelihood();
+    T minTime = timeLogRatio.getLowEdge(), maxTime = timeLogRatio.getUpEdge();
+
+    constexpr std::size_t blockSize = 256;//the table lookups write to local buffers, which cannot alias the tables
+    std::array<T, blockSize> blockLogLikelihoods;
+    std::array<std::uint8_t, blockSize> blockCorrelations;
+    for(std::size_t blockStart = 0; blockStart < numberOfSingles; blockStart += blockSize){
+      
+      auto blockLenght = std::min(blockSize, numberOfSingles - blockStart);
+      for(std::size_t k = 0; k < blockLenght; ++k){
+        
+        auto timeSinceMuon = static_cast<T>(triggerTimes[blockStart + k] - muonTriggerTime);
+        T dx = xs[blockStart + k] - startX, dy = ys[blockStart + k] - startY, dz = zs[blockStart + k] - startZ;
+        auto projection = dx * directionX + dy * directionY + dz * directionZ;
+        auto distance = std::sqrt(std::max(T(0), dx * dx + dy * dy + dz * dz - projection * projection));//vectorised only without errno, e.g. with -fno-math-errno
+        blockLogLikelihoods[k] = distanceLogRatio(distance) + timeLogRatio(timeSinceMuon) + energyLogLikelihood;
+        blockCorrelations[k] = (timeSinceMuon >= minTime) & (timeSinceMuon <= maxTime);
+
+      }
+      for(std::size_t k = 0; k < blockLenght; ++k) logLikelihoods[blockStart + k] = std::max(logLikelihoods[blockStart + k], blockCorrelations[k] ? blockLogLikelihoods[k] : minLogLikelihood);
+
+    }
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::CosmogenicLikelihood)
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef COSMOGENIC_COSMOGENIC_PDF_BUILDER_H
+#define COSMOGENIC_COSMOGENIC_PDF_BUILDER_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+#include "Cosmogenic/Histogram.hpp"
+#include "Cosmogenic/CosmogenicLikelihood.hpp"
+#include "Cosmogenic/WorkStealingPool.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class CosmogenicPDFBuilder{//histograms of the muon-single pairs used to train a CosmogenicLikelihood: muons within the on-time window before the single are cosmogenic or accidental, muons within the off-time window (further back) only accidental
+  
+  public:
+    enum Variable : unsigned {distance, time, energy, numberOfVariables};//distance to the muon track, time since the muon (off-time shift subtracted), muon visible energy
+
+  private:
+    Bounds<TriggerTime> onTimeBounds;//time since the muon
+    TriggerTime offTimeShift;//the off-time window is the on-time window shifted back by 'offTimeShift'
+    std::array<Histogram<T>, numberOfVariables> onTimeHistograms;
+    std::array<Histogram<T>, numberOfVariables> offTimeHistograms;
+    unsigned long numberOfSingles;
+    template <class K>
+    void fill(const Point<T>& position, TriggerTime triggerTime, const Muon<K>& muon);
+
+  public:
+    CosmogenicPDFBuilder(const Bounds<TriggerTime>& onTimeBounds, TriggerTime offTimeShift, Histogram<T> distanceHistogram, Histogram<T> timeHistogram, Histogram<T> energyHistogram);//the muon window of the candidate trees must reach back to 'onTimeBounds.getUpEdge() + offTimeShift'
+    const Bounds<TriggerTime>& getOnTimeBounds() const;
+    TriggerTime getOffTimeShift() const;
+    unsigned long getNumberOfSingles() const;
+    const Histogram<T>& getOnTimeHistogram(Variable variable) const;
+    const Histogram<T>& getOffTimeHistogram(Variable variable) const;
+    Histogram<T> getCosmogenicHistogram(Variable variable) const;//on-time minus off-time
+    TabulatedFunction<T> getCosmogenicPDF(Variable variable) const;
+    TabulatedFunction<T> getAccidentalPDF(Variable variable) const;
+    CosmogenicLikelihood<T> getCosmogenicLikelihood() const;
+    template <class Payload, class Muons>
+    void fill(const Single<T, Payload>& single, const Muons& muons);//'muons' holds Muon's or muon Shower's
+    template <class CandidateTree>
+    void fill(const CandidateTree& candidateTree);//the prompt and the muon showers of a CandidateTree or LazyCandidateTree
+    template <class Iterator>
+    void fill(Iterator begin, Iterator end, const WorkStealingPool& pool);//e.g. the candidate trees of a run, filled into one sub-histogram per worker merged at the end, the counts are the same whatever the number of workers
+    void clear();//keeps the binning
+    CosmogenicPDFBuilder<T>& operator += (const CosmogenicPDFBuilder<T>& other);
+
+  };
+
+  template <class T>
+  template <class K>
+  void CosmogenicPDFBuilder<T>::fill(const Point<T>& position, TriggerTime triggerTime, const Muon<K>& muon){
+    
+    auto timeSinceMuon = triggerTime - muon.getTriggerTime();
+    std::array<Histogram<T>, numberOfVariables>* histograms = nullptr;
+    if(onTimeBounds.contains(timeSinceMuon)) histograms = &onTimeHistograms;
+    else if(onTimeBounds.contains(timeSinceMuon - offTimeShift)){
+      
+      histograms = &offTimeHistograms;
+      timeSinceMuon -= offTimeShift;//same binning as on-time
+
+    }
+    else return;
+
+    (*histograms)[Variable::distance].fill(getDistanceToLine(position, muon.getTrack()));
+    (*histograms)[Variable::time].fill(static_cast<T>(timeSinceMuon));
+    (*histograms)[Variable::energy].fill(muon.template Event<K>::getVisibleEnergy());
+
+  }
+
+  template <class T>
+  CosmogenicPDFBuilder<T>::CosmogenicPDFBuilder(const Bounds<TriggerTime>& onTimeBounds, TriggerTime offTimeShift, Histogram<T> distanceHistogram, Histogram<T> timeHistogram, Histogram<T> energyHistogram)
+  :onTimeBounds(onTimeBounds),offTimeShift(offTimeShift),onTimeHistograms{distanceHistogram, timeHistogram, energyHistogram},offTimeHistograms{distanceHistogram, timeHistogram, energyHistogram},numberOfSingles(0){
+    
+    if(onTimeBounds.getLowEdge() < 0) throw std::invalid_argument(std::to_string(onTimeBounds.getLowEdge())+"ns is not a valid lower edge for the time since the muon.");
+    if(offTimeShift < onTimeBounds.getWidth()) throw std::invalid_argument(std::to_string(offTimeShift)+"ns is not a valid off-time shift, the off-time window would overlap the on-time one.");
+    clear();
+
+  }
+
+  template <class T>
+  const Bounds<TriggerTime>& CosmogenicPDFBuilder<T>::getOnTimeBounds() const{
+    
+    return onTimeBounds;
+
+  }
+
+  template <class T>
+  TriggerTime CosmogenicPDFBuilder<T>::getOffTimeShift() const{
+    
+    return offTimeShift;
+
+  }
+
+  template <class T>
+  unsigned long CosmogenicPDFBuilder<T>::getNumberOfSingles() const{
+    
+    return numberOfSingles;
+
+  }
+
+  template <class T>
+  const Histogram<T>& CosmogenicPDFBuilder<T>::getOnTimeHistogram(Variable variable) const{
+    
+    return onTimeHistograms.at(variable);
+
+  }
+
+  template <class T>
+  const Histogram<T>& CosmogenicPDFBuilder<T>::getOffTimeHistogram(Variable variable) const{
+    
+    return offTimeHistograms.at(variable);
+
+  }
+
+  template <class T>
+  Histogram<T> CosmogenicPDFBuilder<T>::getCosmogenicHistogram(Variable variable) const{
+    
+    auto cosmogenicHistogram = getOnTimeHistogram(variable);
+    cosmogenicHistogram -= getOffTimeHistogram(variable);//both windows have the same width
+    return cosmogenicHistogram;
+
+  }
+
+  template <class T>
+  TabulatedFunction<T> CosmogenicPDFBuilder<T>::getCosmogenicPDF(Variable variable) const{
+    
+    return getCosmogenicHistogram(variable).getPDF();
+
+  }
+
+  template <class T>
+  TabulatedFunction<T> CosmogenicPDFBuilder<T>::getAccidentalPDF(Variable variable) const{
+    
+    return getOffTimeHistogram(variable).getPDF();
+
+  }
+
+  template <class T>
+  CosmogenicLikelihood<T> CosmogenicPDFBuilder<T>::getCosmogenicLikelihood() const{
+    
+    return CosmogenicLikelihood<T>(getCosmogenicPDF(Variable::distance), getAccidentalPDF(Variable::distance), getCosmogenicPDF(Variable::time), getAccidentalPDF(Variable::time), getCosmogenicPDF(Variable::energy), getAccidentalPDF(Variable::energy));
+
+  }
+
+  template <class T>
+  template <class Payload, class Muons>
+  void CosmogenicPDFBuilder<T>::fill(const Single<T, Payload>& single, const Muons& muons){
+    
+    const auto& position = single.getPositionInformation().getPosition();
+    for(const auto& muon : muons) fill(position, single.getTriggerTime(), getMuon(muon));
+    ++numberOfSingles;
+
+  }
+
+  template <class T>
+  template <class CandidateTree>
+  void CosmogenicPDFBuilder<T>::fill(const CandidateTree& candidateTree){
+    
+    fill(candidateTree.getCandidatePair().getPrompt(), candidateTree.getMuonShowers());
+
+  }
+
+  template <class T>
+  template <class Iterator>
+  void CosmogenicPDFBuilder<T>::fill(Iterator begin, Iterator end, const WorkStealingPool& pool){
+    
+    auto emptyBuilder = *this;
+    emptyBuilder.clear();
+    std::vector<CosmogenicPDFBuilder<T>> workerBuilders(pool.getNumberOfThreads(), emptyBuilder);//per worker, no locking nor shared cache line in the hot loop
+
+    std::size_t numberOfItems = std::distance(begin, end);
+    std::size_t chunkSize = std::max<std::size_t>(1, numberOfItems / (8 * pool.getNumberOfThreads()));//several chunks per worker to balance the load
+    std::vector<std::function<void(unsigned)>> tasks;
+    for(std::size_t chunkStart = 0; chunkStart < numberOfItems; chunkStart += chunkSize){
+      
+      auto chunkEnd = std::min(chunkStart + chunkSize, numberOfItems);
+      tasks.emplace_back([&, chunkStart, chunkEnd](unsigned workerIndex){
+        
+        auto& workerBuilder = workerBuilders[workerIndex];
+        for(auto it = std::next(begin, chunkStart); it != std::next(begin, chunkEnd); ++it) workerBuilder.fill(*it);
+
+      });
+
+    }
+
+    pool.execute(std::move(tasks));
+    for(const auto& workerBuilder : workerBuilders) *this += workerBuilder;
+
+  }
+
+  template <class T>
+  void CosmogenicPDFBuilder<T>::clear(){
+    
+    for(auto& histogram : onTimeHistograms) histogram.clear();
+    for(auto& histogram : offTimeHistograms) histogram.clear();
+    numberOfSingles = 0;
+
+  }
+
+  template <class T>
+  CosmogenicPDFBuilder<T>& CosmogenicPDFBuilder<T>::operator += (const CosmogenicPDFBuilder<T>& other){
+    
+    if(onTimeBounds.getLowEdge() != other.onTimeBounds.getLowEdge() || onTimeBounds.getUpEdge() != other.onTimeBounds.getUpEdge() || offTimeShift != other.offTimeShift) throw std::invalid_argument("Cannot merge cosmogenic PDF builders with different time windows.");
+
+    for(unsigned k = 0; k < numberOfVariables; ++k){
+      
+      onTimeHistograms[k] += other.onTimeHistograms[k];
+      offTimeHistograms[k] += other.offTimeHistograms[k];
+
+    }
+    numberOfSingles += other.numberOfSingles;
+    return *this;
+
+  }
+
+}
+
+#endif
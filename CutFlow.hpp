@@ -0,0 +1,109 @@
+#ifndef COSMOGENIC_CUT_FLOW_H
+#define COSMOGENIC_CUT_FLOW_H
+
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "cereal/types/string.hpp"
+#include "cereal/types/utility.hpp"
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+
+namespace CosmogenicHunter{
+
+  class CutFlow{//named counters kept in the order they were first incremented
+    
+    std::vector<std::pair<std::string, unsigned long>> counters;
+    std::vector<std::pair<std::string, unsigned long>>::iterator findCounter(const std::string& cutName);
+    friend class cereal::access;
+    template <class Archive>
+    void serialize(Archive& archive, std::uint32_t version);
+    
+  public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    CutFlow() = default;
+    unsigned getNumberOfCuts() const;
+    unsigned long getCount(const std::string& cutName) const;//zero for unknown cuts
+    void increment(const std::string& cutName, unsigned long count = 1);
+    CutFlow& operator += (const CutFlow& other);//counters unknown to this cut flow are appended in the order of 'other'
+    void print(std::ostream& output, unsigned outputOffset) const;
+    
+  };
+  
+  inline std::vector<std::pair<std::string, unsigned long>>::iterator CutFlow::findCounter(const std::string& cutName){
+    
+    return std::find_if(counters.begin(), counters.end(), [&](const auto& counter){return counter.first == cutName;});
+
+  }
+  
+  template <class Archive>
+  void CutFlow::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(counters);
+    else throw std::runtime_error(getUnknownVersionMessage<CutFlow>("CutFlow", version));
+
+  }
+  
+  inline unsigned CutFlow::getNumberOfCuts() const{
+    
+    return counters.size();
+
+  }
+  
+  inline unsigned long CutFlow::getCount(const std::string& cutName) const{
+    
+    auto itCounter = std::find_if(counters.begin(), counters.end(), [&](const auto& counter){return counter.first == cutName;});
+    if(itCounter != counters.end()) return itCounter->second;
+    else return 0;
+
+  }
+  
+  inline void CutFlow::increment(const std::string& cutName, unsigned long count){
+    
+    auto itCounter = findCounter(cutName);
+    if(itCounter != counters.end()) itCounter->second += count;
+    else counters.emplace_back(cutName, count);
+
+  }
+  
+  inline CutFlow& CutFlow::operator += (const CutFlow& other){
+    
+    for(const auto& counter : other.counters) increment(counter.first, counter.second);
+    return *this;
+
+  }
+  
+  inline void CutFlow::print(std::ostream& output, unsigned outputOffset) const{
+    
+    unsigned firstColumnWidth = 0;
+    for(const auto& counter : counters) firstColumnWidth = std::max<unsigned>(firstColumnWidth, counter.first.size());
+    
+    for(auto itCounter = counters.begin(); itCounter != counters.end(); ++itCounter){
+      
+      if(itCounter != counters.begin()) output<<"\n";
+      output<<std::setw(outputOffset)<<std::left<<""<<std::setw(firstColumnWidth)<<std::left<<itCounter->first<<": "<<std::setw(10)<<std::right<<itCounter->second;
+      
+    }
+
+  }
+  
+  inline std::ostream& operator<<(std::ostream& output, const CutFlow& cutFlow){
+    
+    cutFlow.print(output, 0);
+    return output;
+    
+  }
+  
+  inline CutFlow operator + (CutFlow cutFlow1, const CutFlow& cutFlow2){
+    
+    cutFlow1 += cutFlow2;
+    return cutFlow1;
+    
+  }
+
+}
+
+CEREAL_CLASS_VERSION(CosmogenicHunter::CutFlow, CosmogenicHunter::CutFlow::serializationVersion)
+
+#endif
@@ -5,6 +5,8 @@
 #include "cereal/archives/binary.hpp"
 #include "cereal/types/polymorphic.hpp"
 #include "Cosmogenic/Bounds.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+#include "Cosmogenic/TriggerTime.hpp"
 
 namespace CosmogenicHunter{
 
@@ -13,27 +15,31 @@ namespace CosmogenicHunter{
   
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   protected:
-    double triggerTime;
+    TriggerTime triggerTime;
     T visibleEnergy;
     unsigned identifier;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//members of the derived class written before the archives were versioned
 
   public:
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(1);//to be incremented (by 2) whenever the serialized members change
     Event();
-    Event(double triggerTime, T visibleEnergy, unsigned identifier);
+    Event(TriggerTime triggerTime, T visibleEnergy, unsigned identifier);
     Event(const Event<T>& other) = default;
     Event(Event&& other) = default;
     Event& operator = (const Event<T>& other) = default;
     Event& operator = (Event&& other) = default;
     virtual ~Event() = default;//custom destructor implies to define (even if default-ed) all copy / move / assignement operations
-    double getTriggerTime() const;
+    TriggerTime getTriggerTime() const;
     T getVisibleEnergy() const;
     unsigned getIdentifier() const;//identifier of the event within the corresponding run
-    double getTimeCorrelation(const Event<T>& other) const;
-    bool isTimeCorrelated(const Event<T>& other, const Bounds<double>& timeBounds) const;
+    TriggerTime getTimeCorrelation(const Event<T>& other) const;
+    bool isTimeCorrelated(const Event<T>& other, const Bounds<TriggerTime>& timeBounds) const;
     bool hasVisibleEnergyWithin(const Bounds<T>& energyBounds) const;
+    void shiftTriggerTime(TriggerTime timeShift);//e.g. to bring several runs on a common time axis
     virtual void print(std::ostream& output, unsigned outputOffset) const;//needed to act as if 'operator<<' was virtual
     bool isEqualTo(const Event<T>& other) const;//checks identifiers only
     
@@ -41,9 +47,25 @@ namespace CosmogenicHunter{
   
   template<class T>
   template <class Archive>
-  void Event<T>::serialize(Archive& archive){
+  void Event<T>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(triggerTime, visibleEnergy, identifier);//fast path: the archive was written with the current layout
+    else if(version == getForeignTriggerTimeVersion(1)){//written with the other trigger time representation
+      
+      loadForeignTriggerTime(archive, triggerTime);
+      archive(visibleEnergy, identifier);
+      
+    }
+    else throw std::runtime_error(getUnknownVersionMessage<Event<T>>("Event", version));
+
+  }
+  
+  template<class T>
+  template <class Archive>
+  void Event<T>::loadUnversioned(Archive& archive){
     
-    archive(triggerTime, visibleEnergy, identifier);
+    loadUnversionedTriggerTime(archive, triggerTime);
+    archive(visibleEnergy, identifier);
 
   }
   
@@ -53,12 +75,12 @@ namespace CosmogenicHunter{
   }
 
   template<class T>
-  Event<T>::Event(double triggerTime, T visibleEnergy, unsigned identifier):triggerTime(triggerTime),visibleEnergy(visibleEnergy),identifier(identifier){
+  Event<T>::Event(TriggerTime triggerTime, T visibleEnergy, unsigned identifier):triggerTime(triggerTime),visibleEnergy(visibleEnergy),identifier(identifier){
     
   }
 
   template<class T>
-  double Event<T>::getTriggerTime() const{
+  TriggerTime Event<T>::getTriggerTime() const{
     
     return triggerTime;
 
@@ -79,7 +101,7 @@ namespace CosmogenicHunter{
   }
     
   template <class T>
-  double Event<T>::getTimeCorrelation(const Event<T>& other) const{
+  TriggerTime Event<T>::getTimeCorrelation(const Event<T>& other) const{
 
     return std::abs(this->triggerTime - other.triggerTime);
   
@@ -87,7 +109,7 @@ namespace CosmogenicHunter{
   
     
   template <class T>
-  bool Event<T>::isTimeCorrelated(const Event<T>& other, const Bounds<double>& timeBounds) const{
+  bool Event<T>::isTimeCorrelated(const Event<T>& other, const Bounds<TriggerTime>& timeBounds) const{
     
     return timeBounds.contains(getTimeCorrelation(other));
 
@@ -100,6 +122,13 @@ namespace CosmogenicHunter{
 
   }
   
+  template<class T>
+  void Event<T>::shiftTriggerTime(TriggerTime timeShift){
+    
+    triggerTime += timeShift;
+
+  }
+  
   template<class T>
   void Event<T>::print(std::ostream& output, unsigned outputOffset) const{
 
@@ -140,14 +169,14 @@ namespace CosmogenicHunter{
   }
     
   template <class T>
-  double getTimeCorrelation(const Event<T>& single1, const Event<T>& single2){
+  TriggerTime getTimeCorrelation(const Event<T>& single1, const Event<T>& single2){
 
     return single1.getTimeCorrelation(single2);
   
   }
     
   template <class T>
-  bool areTimeCorrelated(const Event<T>& single1, const Event<T>& single2, const Bounds<double>& timeBounds){
+  bool areTimeCorrelated(const Event<T>& single1, const Event<T>& single2, const Bounds<TriggerTime>& timeBounds){
 
     return single1.isTimeCorrelated(single2, timeBounds);
   
@@ -155,4 +184,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Event)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,167 @@
+#ifndef COSMOGENIC_EVENT_MERGER_H
+#define COSMOGENIC_EVENT_MERGER_H
+
+#include <tuple>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include "Cosmogenic/EventStream.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class... Events>
+  class EventMerger{//k-way merge of time-ordered streams of possibly different event types into a single time-ordered flow
+    
+    struct StreamHead{
+      
+      TriggerTime triggerTime;
+      unsigned typeIndex;//position of the event type in 'Events...'
+      unsigned streamIndex;//position of the stream among the streams of that type
+      bool operator>(const StreamHead& other) const;//ties are broken by type and stream order so that the merged flow is deterministic
+      
+    };
+    
+    std::tuple<std::vector<EventStream<Events>>...> streams;
+    std::vector<StreamHead> heads;//min-heap on trigger times
+    template <class Event>
+    static constexpr std::size_t getTypeIndex();
+    template <std::size_t I>
+    void pushHead(unsigned streamIndex);
+    template <std::size_t I, class Visitor>
+    void popFrom(const StreamHead& head, Visitor&& visitor);
+    
+  public:
+    EventMerger() = default;
+    template <class Event>
+    void addStream(EventStream<Event> stream);
+    unsigned getNumberOfStreams() const;
+    template <class Event>
+    std::vector<unsigned long long> getNumberOfPoppedEvents() const;//per stream of type Event in the order they were added, to checkpoint the merge (skip them in new streams to resume)
+    bool isEmpty() const;
+    TriggerTime getNextTriggerTime() const;
+    template <class Visitor>
+    void popNext(Visitor&& visitor);//calls 'visitor' with the oldest pending event (Visitor must accept all of 'Events...')
+    template <class Visitor>
+    void forEach(Visitor&& visitor);//pops all events in time order
+    
+  };
+  
+  template <class... Events>
+  bool EventMerger<Events...>::StreamHead::operator>(const StreamHead& other) const{
+    
+    return std::tie(triggerTime, typeIndex, streamIndex) > std::tie(other.triggerTime, other.typeIndex, other.streamIndex);
+
+  }
+  
+  template <class... Events>
+  template <class Event>
+  constexpr std::size_t EventMerger<Events...>::getTypeIndex(){
+    
+    constexpr bool isSameType[] = {std::is_same<Event, Events>::value...};
+    for(std::size_t k = 0; k < sizeof...(Events); ++k) if(isSameType[k]) return k;
+    return sizeof...(Events);
+
+  }
+  
+  template <class... Events>
+  template <std::size_t I>
+  void EventMerger<Events...>::pushHead(unsigned streamIndex){
+    
+    auto& stream = std::get<I>(streams)[streamIndex];
+    if(!stream.isEmpty()){
+      
+      heads.push_back(StreamHead{stream.front().getTriggerTime(), I, streamIndex});
+      std::push_heap(heads.begin(), heads.end(), std::greater<StreamHead>());
+      
+    }
+    
+  }
+  
+  template <class... Events>
+  template <std::size_t I, class Visitor>
+  void EventMerger<Events...>::popFrom(const StreamHead& head, Visitor&& visitor){
+    
+    if constexpr(I < sizeof...(Events)){
+      
+      if(head.typeIndex == I){
+        
+        visitor(std::get<I>(streams)[head.streamIndex].popFront());
+        pushHead<I>(head.streamIndex);
+        
+      }
+      else popFrom<I + 1>(head, std::forward<Visitor>(visitor));
+      
+    }
+    
+  }
+  
+  template <class... Events>
+  template <class Event>
+  void EventMerger<Events...>::addStream(EventStream<Event> stream){
+    
+    constexpr auto typeIndex = getTypeIndex<Event>();
+    static_assert(typeIndex < sizeof...(Events), "The stream event type must be one of the merged event types.");
+    
+    auto& typeStreams = std::get<typeIndex>(streams);
+    typeStreams.push_back(std::move(stream));
+    pushHead<typeIndex>(typeStreams.size() - 1);
+    
+  }
+  
+  template <class... Events>
+  unsigned EventMerger<Events...>::getNumberOfStreams() const{
+    
+    return std::apply([](const auto&... typeStreams){return (0u + ... + typeStreams.size());}, streams);
+
+  }
+  
+  template <class... Events>
+  template <class Event>
+  std::vector<unsigned long long> EventMerger<Events...>::getNumberOfPoppedEvents() const{
+    
+    std::vector<unsigned long long> numbersOfPoppedEvents;
+    for(const auto& stream : std::get<getTypeIndex<Event>()>(streams)) numbersOfPoppedEvents.push_back(stream.getNumberOfPoppedEvents());
+    return numbersOfPoppedEvents;
+
+  }
+  
+  template <class... Events>
+  bool EventMerger<Events...>::isEmpty() const{
+    
+    return heads.empty();
+
+  }
+  
+  template <class... Events>
+  TriggerTime EventMerger<Events...>::getNextTriggerTime() const{
+    
+    if(isEmpty()) throw std::out_of_range("All merged event streams are exhausted.");
+    return heads.front().triggerTime;
+
+  }
+  
+  template <class... Events>
+  template <class Visitor>
+  void EventMerger<Events...>::popNext(Visitor&& visitor){
+    
+    if(isEmpty()) throw std::out_of_range("All merged event streams are exhausted.");
+    
+    std::pop_heap(heads.begin(), heads.end(), std::greater<StreamHead>());
+    auto head = heads.back();
+    heads.pop_back();
+    popFrom<0>(head, std::forward<Visitor>(visitor));
+
+  }
+  
+  template <class... Events>
+  template <class Visitor>
+  void EventMerger<Events...>::forEach(Visitor&& visitor){
+    
+    while(!isEmpty()) popNext(visitor);
+
+  }
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef COSMOGENIC_EVENT_STORE_H
+#define COSMOGENIC_EVENT_STORE_H
+
+#include <deque>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "Cosmogenic/Bounds.hpp"
+#include "Cosmogenic/TriggerTime.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class Event>
+  class EventStore{//append-only, time-ordered events (e.g. all the muons of a run) that views can share and query by time
+    
+    std::deque<Event> events;//references stay valid when appending
+    
+  public:
+    using const_iterator = typename std::deque<Event>::const_iterator;
+    EventStore() = default;
+    unsigned getNumberOfEvents() const;
+    bool isEmpty() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lowerBound(TriggerTime triggerTime) const;//first event at or after 'triggerTime'
+    std::pair<const_iterator, const_iterator> getRange(const Bounds<TriggerTime>& timeBounds) const;//events in [low, up[
+    const Event* getLastBefore(TriggerTime triggerTime) const;//nullptr if there is none
+    void pushBackEvent(Event event);
+    template <class... Args>
+    void emplaceEvent(Args&&... args);
+    
+  };
+  
+  template <class Event>
+  unsigned EventStore<Event>::getNumberOfEvents() const{
+    
+    return events.size();
+
+  }
+  
+  template <class Event>
+  bool EventStore<Event>::isEmpty() const{
+    
+    return events.empty();
+
+  }
+  
+  template <class Event>
+  typename EventStore<Event>::const_iterator EventStore<Event>::begin() const{
+    
+    return events.begin();
+
+  }
+  
+  template <class Event>
+  typename EventStore<Event>::const_iterator EventStore<Event>::end() const{
+    
+    return events.end();
+
+  }
+  
+  template <class Event>
+  typename EventStore<Event>::const_iterator EventStore<Event>::lowerBound(TriggerTime triggerTime) const{
+    
+    return std::lower_bound(events.begin(), events.end(), triggerTime, [](const auto& event, TriggerTime time){return event.getTriggerTime() < time;});
+
+  }
+  
+  template <class Event>
+  std::pair<typename EventStore<Event>::const_iterator, typename EventStore<Event>::const_iterator> EventStore<Event>::getRange(const Bounds<TriggerTime>& timeBounds) const{
+    
+    auto itFirst = lowerBound(timeBounds.getLowEdge());
+    auto itLast = std::lower_bound(itFirst, events.end(), timeBounds.getUpEdge(), [](const auto& event, TriggerTime time){return event.getTriggerTime() < time;});
+    return std::make_pair(itFirst, itLast);
+
+  }
+  
+  template <class Event>
+  const Event* EventStore<Event>::getLastBefore(TriggerTime triggerTime) const{
+    
+    auto itFirstAfter = lowerBound(triggerTime);
+    if(itFirstAfter == events.begin()) return nullptr;
+    else return &*std::prev(itFirstAfter);
+
+  }
+  
+  template <class Event>
+  void EventStore<Event>::pushBackEvent(Event event){
+    
+    if(!events.empty() && event.getTriggerTime() < events.back().getTriggerTime()) throw std::invalid_argument("Event "+std::to_string(event.getIdentifier())+" at "+std::to_string(event.getTriggerTime())+"ns breaks the time ordering of the store.");
+    events.push_back(std::move(event));
+
+  }
+  
+  template <class Event>
+  template <class... Args>
+  void EventStore<Event>::emplaceEvent(Args&&... args){
+    
+    pushBackEvent(Event(std::forward<Args>(args)...));
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef COSMOGENIC_EVENT_STREAM_H
+#define COSMOGENIC_EVENT_STREAM_H
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "Cosmogenic/TriggerTime.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class Event>
+  class EventStream{//lazily reads time-ordered events by batches of at most 'bufferSize' events
+    
+    std::function<bool(Event&)> reader;//fills the event and returns false once the input is exhausted
+    TriggerTime timeOffset;//added to the trigger time of every event read
+    unsigned bufferSize;
+    std::deque<Event> buffer;
+    bool exhausted;
+    TriggerTime lastTriggerTime;
+    unsigned long long numberOfPoppedEvents;
+    void refill();
+    
+  public:
+    EventStream(std::function<bool(Event&)> reader, TriggerTime timeOffset = 0, unsigned bufferSize = 1024);
+    TriggerTime getTimeOffset() const;
+    unsigned getBufferSize() const;
+    bool isEmpty();//reads the next batch if the buffer is empty
+    const Event& front();
+    Event popFront();
+    unsigned long long getNumberOfPoppedEvents() const;//offset of the stream in its input, e.g. to checkpoint it
+    void skip(unsigned long long numberOfEvents);//pops and drops events, e.g. to resume from a checkpoint
+    
+  };
+  
+  template <class Event>
+  void EventStream<Event>::refill(){
+    
+    while(buffer.size() < bufferSize && !exhausted){
+      
+      Event event;
+      if(reader(event)){
+        
+        event.shiftTriggerTime(timeOffset);
+        if(event.getTriggerTime() < lastTriggerTime) throw std::runtime_error("Event "+std::to_string(event.getIdentifier())+" at "+std::to_string(event.getTriggerTime())+"ns breaks the time ordering of the stream.");
+        lastTriggerTime = event.getTriggerTime();
+        buffer.push_back(std::move(event));
+        
+      }
+      else exhausted = true;
+      
+    }
+    
+  }
+  
+  template <class Event>
+  EventStream<Event>::EventStream(std::function<bool(Event&)> reader, TriggerTime timeOffset, unsigned bufferSize)
+  :reader(std::move(reader)),timeOffset(timeOffset),bufferSize(bufferSize),exhausted(false),lastTriggerTime(std::numeric_limits<TriggerTime>::lowest()),numberOfPoppedEvents(0){
+    
+    if(bufferSize == 0) throw std::invalid_argument("The buffer of an event stream cannot be empty.");
+    
+  }
+
+  template <class Event>
+  TriggerTime EventStream<Event>::getTimeOffset() const{
+    
+    return timeOffset;
+
+  }
+  
+  template <class Event>
+  unsigned EventStream<Event>::getBufferSize() const{
+    
+    return bufferSize;
+
+  }
+  
+  template <class Event>
+  bool EventStream<Event>::isEmpty(){
+    
+    if(buffer.empty()) refill();
+    return buffer.empty();
+
+  }
+  
+  template <class Event>
+  const Event& EventStream<Event>::front(){
+    
+    if(isEmpty()) throw std::out_of_range("Cannot access the front of an exhausted event stream.");
+    return buffer.front();
+
+  }
+  
+  template <class Event>
+  Event EventStream<Event>::popFront(){
+    
+    if(isEmpty()) throw std::out_of_range("Cannot pop an event from an exhausted event stream.");
+    auto event = std::move(buffer.front());
+    buffer.pop_front();
+    ++numberOfPoppedEvents;
+    return event;
+
+  }
+  
+  template <class Event>
+  unsigned long long EventStream<Event>::getNumberOfPoppedEvents() const{
+    
+    return numberOfPoppedEvents;
+
+  }
+  
+  template <class Event>
+  void EventStream<Event>::skip(unsigned long long numberOfEvents){
+    
+    for(unsigned long long k = 0; k < numberOfEvents; ++k){
+      
+      if(isEmpty()) throw std::out_of_range("Cannot skip "+std::to_string(numberOfEvents)+" events of a stream holding only "+std::to_string(k)+".");
+      buffer.pop_front();
+      ++numberOfPoppedEvents;
+      
+    }
+
+  }
+
+}
+
+#endif
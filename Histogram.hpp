@@ -0,0 +1,260 @@
+#ifndef COSMOGENIC_HISTOGRAM_H
+#define COSMOGENIC_HISTOGRAM_H
+
+#include <vector>
+#include <iomanip>
+#include <stdexcept>
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+#include "Cosmogenic/TabulatedFunction.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class Histogram{//fixed binning, so that the bin of a value takes one multiplication
+    
+    T lowEdge;
+    T upEdge;
+    T inverseBinWidth;
+    std::vector<double> binContents;
+    double underflow;
+    double overflow;//NaN's included
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive, std::uint32_t version) const;
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t version);
+    void checkBinning(const Histogram<T>& other) const;
+
+  public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    Histogram();
+    Histogram(T lowEdge, T upEdge, unsigned numberOfBins);
+    T getLowEdge() const;
+    T getUpEdge() const;
+    unsigned getNumberOfBins() const;
+    T getBinWidth() const;
+    T getBinCenter(unsigned binIndex) const;
+    double getBinContent(unsigned binIndex) const;
+    double getUnderflow() const;
+    double getOverflow() const;
+    double getIntegral() const;//of the bins within the edges
+    bool hasSameBinning(const Histogram<T>& other) const;
+    void fill(T value, double weight = 1);
+    void scale(double factor);
+    void clear();//keeps the binning
+    Histogram<T>& operator += (const Histogram<T>& other);//e.g. to merge the histograms of several workers
+    Histogram<T>& operator -= (const Histogram<T>& other);//e.g. to subtract an off-time histogram
+    TabulatedFunction<T> getPDF() const;//density at the bin centers, normalised to the bins within the edges, negative contents (e.g. from a subtraction) count as empty
+    void print(std::ostream& output, unsigned outputOffset) const;
+
+  };
+
+  template <class T>
+  template <class Archive>
+  void Histogram<T>::save(Archive& archive, std::uint32_t) const{
+    
+    archive(lowEdge, upEdge, binContents, underflow, overflow);
+
+  }
+
+  template <class T>
+  template <class Archive>
+  void Histogram<T>::load(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(lowEdge, upEdge, binContents, underflow, overflow);
+    else throw std::runtime_error(getUnknownVersionMessage<Histogram<T>>("Histogram", version));
+
+    inverseBinWidth = binContents.size() / (upEdge - lowEdge);
+
+  }
+
+  template <class T>
+  void Histogram<T>::checkBinning(const Histogram<T>& other) const{
+    
+    if(!hasSameBinning(other)) throw std::invalid_argument("Cannot combine histograms with different binnings.");
+
+  }
+
+  template <class T>
+  Histogram<T>::Histogram():Histogram(0, 1, 1){
+  
+  }
+
+  template <class T>
+  Histogram<T>::Histogram(T lowEdge, T upEdge, unsigned numberOfBins):lowEdge(lowEdge),upEdge(upEdge),binContents(numberOfBins),underflow(0),overflow(0){
+    
+    if(!(lowEdge < upEdge) || numberOfBins == 0){
+      
+      auto errorMessage = std::to_string(lowEdge)+", "+std::to_string(upEdge)+" and "+std::to_string(numberOfBins)+" are not valid edges and number of bins for a histogram.";
+      throw std::invalid_argument(errorMessage);
+
+    }
+
+    inverseBinWidth = numberOfBins / (upEdge - lowEdge);
+
+  }
+
+  template <class T>
+  T Histogram<T>::getLowEdge() const{
+    
+    return lowEdge;
+
+  }
+
+  template <class T>
+  T Histogram<T>::getUpEdge() const{
+    
+    return upEdge;
+
+  }
+
+  template <class T>
+  unsigned Histogram<T>::getNumberOfBins() const{
+    
+    return binContents.size();
+
+  }
+
+  template <class T>
+  T Histogram<T>::getBinWidth() const{
+    
+    return (upEdge - lowEdge) / binContents.size();
+
+  }
+
+  template <class T>
+  T Histogram<T>::getBinCenter(unsigned binIndex) const{
+    
+    return lowEdge + (binIndex + T(0.5)) * getBinWidth();
+
+  }
+
+  template <class T>
+  double Histogram<T>::getBinContent(unsigned binIndex) const{
+    
+    return binContents.at(binIndex);
+
+  }
+
+  template <class T>
+  double Histogram<T>::getUnderflow() const{
+    
+    return underflow;
+
+  }
+
+  template <class T>
+  double Histogram<T>::getOverflow() const{
+    
+    return overflow;
+
+  }
+
+  template <class T>
+  double Histogram<T>::getIntegral() const{
+    
+    double integral = 0;
+    for(auto binContent : binContents) integral += binContent;
+    return integral;
+
+  }
+
+  template <class T>
+  bool Histogram<T>::hasSameBinning(const Histogram<T>& other) const{
+    
+    return lowEdge == other.lowEdge && upEdge == other.upEdge && binContents.size() == other.binContents.size();
+
+  }
+
+  template <class T>
+  void Histogram<T>::fill(T value, double weight){
+    
+    auto position = (value - lowEdge) * inverseBinWidth;//in units of the bin width
+    if(position >= 0 && position < binContents.size()) binContents[static_cast<unsigned>(position)] += weight;
+    else if(position < 0) underflow += weight;
+    else overflow += weight;
+
+  }
+
+  template <class T>
+  void Histogram<T>::scale(double factor){
+    
+    for(auto& binContent : binContents) binContent *= factor;
+    underflow *= factor;
+    overflow *= factor;
+
+  }
+
+  template <class T>
+  void Histogram<T>::clear(){
+    
+    std::fill(binContents.begin(), binContents.end(), 0);
+    underflow = 0;
+    overflow = 0;
+
+  }
+
+  template <class T>
+  Histogram<T>& Histogram<T>::operator += (const Histogram<T>& other){
+    
+    checkBinning(other);
+    for(unsigned k = 0; k < binContents.size(); ++k) binContents[k] += other.binContents[k];
+    underflow += other.underflow;
+    overflow += other.overflow;
+    return *this;
+
+  }
+
+  template <class T>
+  Histogram<T>& Histogram<T>::operator -= (const Histogram<T>& other){
+    
+    checkBinning(other);
+    for(unsigned k = 0; k < binContents.size(); ++k) binContents[k] -= other.binContents[k];
+    underflow -= other.underflow;
+    overflow -= other.overflow;
+    return *this;
+
+  }
+
+  template <class T>
+  TabulatedFunction<T> Histogram<T>::getPDF() const{
+    
+    if(binContents.size() < 2) throw std::invalid_argument("Cannot build a PDF from a histogram with a single bin.");
+
+    std::vector<T> densities(binContents.size());
+    for(unsigned k = 0; k < binContents.size(); ++k) densities[k] = std::max(binContents[k], 0.);
+
+    TabulatedFunction<T> PDF(getBinCenter(0), getBinCenter(binContents.size() - 1), std::move(densities));
+    PDF.normalize();
+    return PDF;
+
+  }
+
+  template <class T>
+  void Histogram<T>::print(std::ostream& output, unsigned outputOffset) const{
+    
+    for(unsigned k = 0; k < binContents.size(); ++k){
+      
+      if(k > 0) output<<"\n";
+      output<<std::setw(outputOffset)<<std::left<<""<<std::setw(12)<<std::left<<getBinCenter(k)<<": "<<binContents[k];
+
+    }
+    output<<"\n"<<std::setw(outputOffset)<<std::left<<""<<std::setw(12)<<std::left<<"Underflow"<<": "<<underflow
+      <<"\n"<<std::setw(outputOffset)<<std::left<<""<<std::setw(12)<<std::left<<"Overflow"<<": "<<overflow;
+
+  }
+
+  template <class T>
+  std::ostream& operator<<(std::ostream& output, const Histogram<T>& histogram){
+    
+    histogram.print(output, 0);
+    return output;
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Histogram)
+
+#endif
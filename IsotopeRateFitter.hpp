@@ -0,0 +1,481 @@
+#ifndef COSMOGENIC_ISOTOPE_RATE_FITTER_H
+#define COSMOGENIC_ISOTOPE_RATE_FITTER_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "Cosmogenic/Bounds.hpp"
+#include "Cosmogenic/TriggerTime.hpp"
+#include "Cosmogenic/WorkStealingPool.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T, class K>
+  class CandidateTree;
+
+  template <class T, class K>
+  class LazyCandidateTree;
+
+  class IsotopeRateFitter{//extended unbinned maximum likelihood fit of the time to the last muon: one exponential per isotope (e.g. 9Li and 8He) over a flat accidental background, with yields per muon energy class and lifetimes shared by the classes
+    
+    struct Candidate{
+      
+      double timeToLastMuon;
+      unsigned energyClass;
+
+    };
+
+    Bounds<double> timeBounds;//fit range of the time to the last muon
+    std::vector<double> muonEnergyBounds;//edges of the energy classes of the last muon
+    double muonRate;//the time to the last muon of any event decays with the muon rate, 0 for a flat background
+    std::vector<double> initialLifetimes;
+    std::vector<bool> areLifetimesFixed;
+    std::vector<Candidate> candidates;
+    WorkStealingPool pool;
+    static constexpr std::size_t chunkSize = 1 << 14;//the sums are done per chunk, then added in chunk order so that the result does not depend on the number of threads
+    bool isValid(const std::vector<double>& parameters) const;
+    double getMinusLogLikelihood(const std::vector<double>& parameters, std::vector<double>& gradient, std::size_t chunkStart, std::size_t chunkEnd) const;
+    std::vector<double> getHessian(const std::vector<double>& parameters, const std::vector<unsigned>& freeIndices) const;//central differences of the analytic gradient
+    static bool invert(std::vector<double>& matrix, unsigned dimension);//in place, false if not positive definite
+
+  public:
+    struct Result{
+      
+      std::vector<double> values;
+      std::vector<double> errors;//from the inverse of the Hessian, 0 for the fixed parameters
+      double minusLogLikelihood;
+      unsigned numberOfIterations;
+      bool hasConverged;
+
+    };
+
+    IsotopeRateFitter(const Bounds<double>& timeBounds, std::vector<double> muonEnergyBounds, double muonRate = 0, unsigned numberOfThreads = 1);//times in ns, e.g. 'muonEnergyBounds' {0, 300, 600, 1e9} MeV for three classes
+    unsigned addIsotope(double lifetime, bool isLifetimeFixed = false);//returns the index of the isotope, 'lifetime' is the starting value if it is not fixed: with two free lifetimes (or one free close to a fixed one) the yields are degenerate and the fit usually does not converge
+    unsigned getNumberOfIsotopes() const;
+    unsigned getNumberOfEnergyClasses() const;
+    unsigned getNumberOfParameters() const;
+    unsigned getLifetimeIndex(unsigned isotopeIndex) const;//indices of the parameters
+    unsigned getSignalYieldIndex(unsigned isotopeIndex, unsigned energyClass) const;
+    unsigned getBackgroundYieldIndex(unsigned energyClass) const;
+    bool addCandidate(TriggerTime timeToLastMuon, double muonEnergy);//false if outside of the fit range or of the energy classes
+    template <class T, class K>
+    bool addCandidate(const CandidateTree<T,K>& candidateTree);
+    template <class T, class K>
+    bool addCandidate(const LazyCandidateTree<T,K>& candidateTree);//does not build the showers
+    unsigned getNumberOfCandidates() const;
+    unsigned getNumberOfCandidates(unsigned energyClass) const;
+    void clearCandidates();//e.g. between toys
+    void clear();//same, for RunDriver to fit one toy per run on each worker: give such fitters 'numberOfThreads' 1, every copy starting its own pool
+    std::vector<double> getInitialValues() const;//the lifetimes given to 'addIsotope', 10% of the candidates of each class as signal split between the isotopes
+    double getMinusLogLikelihood(const std::vector<double>& parameters, std::vector<double>& gradient) const;//infinite outside of the physical region, summed on the threads of the pool
+    Result fit() const;
+    Result fit(std::vector<double> initialValues, unsigned maxNumberOfIterations = 500, double tolerance = 1e-6) const;//BFGS started from the Hessian, stops when the estimated distance to the minimum is below 'tolerance'
+
+  };
+
+  inline bool IsotopeRateFitter::isValid(const std::vector<double>& parameters) const{
+    
+    for(unsigned k = 0; k < getNumberOfIsotopes(); ++k) if(!(parameters[getLifetimeIndex(k)] > 0)) return false;
+    for(auto parameter : parameters) if(!std::isfinite(parameter)) return false;
+    return true;
+
+  }
+
+  inline double IsotopeRateFitter::getMinusLogLikelihood(const std::vector<double>& parameters, std::vector<double>& gradient, std::size_t chunkStart, std::size_t chunkEnd) const{
+    
+    auto numberOfIsotopes = getNumberOfIsotopes();
+    auto lowEdge = timeBounds.getLowEdge();
+    auto width = timeBounds.getWidth();
+
+    std::vector<double> decayRates(numberOfIsotopes), normalisations(numberOfIsotopes), logDerivativeOffsets(numberOfIsotopes);
+    for(unsigned k = 0; k < numberOfIsotopes; ++k){
+      
+      decayRates[k] = 1 / parameters[getLifetimeIndex(k)] + muonRate;
+      normalisations[k] = decayRates[k] / -std::expm1(-decayRates[k] * width);//exponential normalised on the fit range
+      logDerivativeOffsets[k] = 1 / decayRates[k] - width / std::expm1(decayRates[k] * width) + lowEdge;//d log(PDF) / d decayRate = offset - time
+
+    }
+    double backgroundNormalisation = muonRate > 0 ? muonRate / -std::expm1(-muonRate * width) : 1 / width;
+
+    double minusLogLikelihood = 0;
+    std::vector<double> signalPDFs(numberOfIsotopes);
+    for(auto itCandidate = candidates.begin() + chunkStart; itCandidate != candidates.begin() + chunkEnd; ++itCandidate){
+      
+      auto time = itCandidate->timeToLastMuon;
+      auto energyClass = itCandidate->energyClass;
+      auto backgroundPDF = backgroundNormalisation * std::exp(-muonRate * (time - lowEdge));
+      auto density = parameters[getBackgroundYieldIndex(energyClass)] * backgroundPDF;
+      for(unsigned k = 0; k < numberOfIsotopes; ++k){
+        
+        signalPDFs[k] = normalisations[k] * std::exp(-decayRates[k] * (time - lowEdge));
+        density += parameters[getSignalYieldIndex(k, energyClass)] * signalPDFs[k];
+
+      }
+      if(!(density > 0)) return std::numeric_limits<double>::infinity();
+
+      minusLogLikelihood -= std::log(density);
+      auto inverseDensity = 1 / density;
+      gradient[getBackgroundYieldIndex(energyClass)] -= backgroundPDF * inverseDensity;
+      for(unsigned k = 0; k < numberOfIsotopes; ++k){
+        
+        auto lifetime = parameters[getLifetimeIndex(k)];
+        gradient[getSignalYieldIndex(k, energyClass)] -= signalPDFs[k] * inverseDensity;
+        gradient[getLifetimeIndex(k)] += parameters[getSignalYieldIndex(k, energyClass)] * signalPDFs[k] * (logDerivativeOffsets[k] - time) * inverseDensity / (lifetime * lifetime);//d decayRate / d lifetime = -1 / lifetime^2
+
+      }
+
+    }
+
+    return minusLogLikelihood;
+
+  }
+
+  inline std::vector<double> IsotopeRateFitter::getHessian(const std::vector<double>& parameters, const std::vector<unsigned>& freeIndices) const{
+    
+    unsigned dimension = freeIndices.size();
+    std::vector<double> hessian(dimension * dimension);
+    std::vector<double> upGradient(parameters.size()), downGradient(parameters.size());
+    for(unsigned k = 0; k < dimension; ++k){
+      
+      auto step = 1e-4 * std::max(std::abs(parameters[freeIndices[k]]), 1.);
+      auto upParameters = parameters, downParameters = parameters;
+      upParameters[freeIndices[k]] += step;
+      downParameters[freeIndices[k]] -= step;
+      if(!std::isfinite(getMinusLogLikelihood(upParameters, upGradient)) || !std::isfinite(getMinusLogLikelihood(downParameters, downGradient))){//one sided at the edge of the physical region
+        
+        upParameters = parameters;
+        upParameters[freeIndices[k]] += 2 * step;
+        getMinusLogLikelihood(upParameters, upGradient);
+        getMinusLogLikelihood(parameters, downGradient);
+        step *= 2;
+
+      }
+      for(unsigned l = 0; l < dimension; ++l) hessian[k * dimension + l] = (upGradient[freeIndices[l]] - downGradient[freeIndices[l]]) / (2 * step);
+
+    }
+
+    for(unsigned k = 0; k < dimension; ++k) for(unsigned l = 0; l < k; ++l) hessian[k * dimension + l] = hessian[l * dimension + k] = (hessian[k * dimension + l] + hessian[l * dimension + k]) / 2;
+    return hessian;
+
+  }
+
+  inline bool IsotopeRateFitter::invert(std::vector<double>& matrix, unsigned dimension){
+    
+    std::vector<double> lower(dimension * dimension, 0);//Cholesky factor
+    for(unsigned k = 0; k < dimension; ++k){
+      
+      for(unsigned l = 0; l <= k; ++l){
+        
+        auto sum = matrix[k * dimension + l];
+        for(unsigned m = 0; m < l; ++m) sum -= lower[k * dimension + m] * lower[l * dimension + m];
+        if(k == l){
+          
+          if(!(sum > 0)) return false;
+          lower[k * dimension + k] = std::sqrt(sum);
+
+        }
+        else lower[k * dimension + l] = sum / lower[l * dimension + l];
+
+      }
+
+    }
+
+    std::vector<double> inverseLower(dimension * dimension, 0);
+    for(unsigned k = 0; k < dimension; ++k){
+      
+      inverseLower[k * dimension + k] = 1 / lower[k * dimension + k];
+      for(unsigned l = 0; l < k; ++l){
+        
+        double sum = 0;
+        for(unsigned m = l; m < k; ++m) sum -= lower[k * dimension + m] * inverseLower[m * dimension + l];
+        inverseLower[k * dimension + l] = sum / lower[k * dimension + k];
+
+      }
+
+    }
+
+    for(unsigned k = 0; k < dimension; ++k){
+      
+      for(unsigned l = 0; l <= k; ++l){
+        
+        double sum = 0;
+        for(unsigned m = k; m < dimension; ++m) sum += inverseLower[m * dimension + k] * inverseLower[m * dimension + l];
+        matrix[k * dimension + l] = matrix[l * dimension + k] = sum;
+
+      }
+
+    }
+
+    return true;
+
+  }
+
+  inline IsotopeRateFitter::IsotopeRateFitter(const Bounds<double>& timeBounds, std::vector<double> muonEnergyBounds, double muonRate, unsigned numberOfThreads)
+  :timeBounds(timeBounds),muonEnergyBounds(std::move(muonEnergyBounds)),muonRate(muonRate),pool(numberOfThreads){
+    
+    if(!(timeBounds.getWidth() > 0)) throw std::invalid_argument(std::to_string(timeBounds.getLowEdge())+"ns and "+std::to_string(timeBounds.getUpEdge())+"ns are not valid fit range edges.");
+    if(this->muonEnergyBounds.size() < 2 || !std::is_sorted(this->muonEnergyBounds.begin(), this->muonEnergyBounds.end())) throw std::invalid_argument("The muon energy class edges must be at least two and sorted.");
+    if(muonRate < 0) throw std::invalid_argument(std::to_string(muonRate)+"/ns is not a valid muon rate.");
+
+  }
+
+  inline unsigned IsotopeRateFitter::addIsotope(double lifetime, bool isLifetimeFixed){
+    
+    if(!(lifetime > 0)) throw std::invalid_argument(std::to_string(lifetime)+"ns is not a valid lifetime.");
+
+    initialLifetimes.push_back(lifetime);
+    areLifetimesFixed.push_back(isLifetimeFixed);
+    return initialLifetimes.size() - 1;
+
+  }
+
+  inline unsigned IsotopeRateFitter::getNumberOfIsotopes() const{
+    
+    return initialLifetimes.size();
+
+  }
+
+  inline unsigned IsotopeRateFitter::getNumberOfEnergyClasses() const{
+    
+    return muonEnergyBounds.size() - 1;
+
+  }
+
+  inline unsigned IsotopeRateFitter::getNumberOfParameters() const{
+    
+    return getNumberOfIsotopes() + (getNumberOfIsotopes() + 1) * getNumberOfEnergyClasses();
+
+  }
+
+  inline unsigned IsotopeRateFitter::getLifetimeIndex(unsigned isotopeIndex) const{
+    
+    return isotopeIndex;
+
+  }
+
+  inline unsigned IsotopeRateFitter::getSignalYieldIndex(unsigned isotopeIndex, unsigned energyClass) const{
+    
+    return getNumberOfIsotopes() + isotopeIndex * getNumberOfEnergyClasses() + energyClass;
+
+  }
+
+  inline unsigned IsotopeRateFitter::getBackgroundYieldIndex(unsigned energyClass) const{
+    
+    return getNumberOfIsotopes() * (1 + getNumberOfEnergyClasses()) + energyClass;
+
+  }
+
+  inline bool IsotopeRateFitter::addCandidate(TriggerTime timeToLastMuon, double muonEnergy){
+    
+    double time = timeToLastMuon;
+    if(!timeBounds.contains(time) || muonEnergy < muonEnergyBounds.front() || muonEnergy >= muonEnergyBounds.back()) return false;
+
+    unsigned energyClass = std::upper_bound(muonEnergyBounds.begin(), muonEnergyBounds.end(), muonEnergy) - muonEnergyBounds.begin() - 1;
+    candidates.push_back(Candidate{time, energyClass});
+    return true;
+
+  }
+
+  template <class T, class K>
+  bool IsotopeRateFitter::addCandidate(const CandidateTree<T,K>& candidateTree){
+    
+    const auto& muonShowers = candidateTree.getMuonShowers();
+    if(muonShowers.isEmpty()) return false;
+
+    const auto& lastMuon = muonShowers.back().getInitiator();
+    return addCandidate(candidateTree.getCandidatePair().getPrompt().getTriggerTime() - lastMuon.getTriggerTime(), lastMuon.template Event<K>::getVisibleEnergy());
+
+  }
+
+  template <class T, class K>
+  bool IsotopeRateFitter::addCandidate(const LazyCandidateTree<T,K>& candidateTree){
+    
+    auto lastMuon = candidateTree.getLastMuon();
+    if(lastMuon == nullptr) return false;
+
+    return addCandidate(candidateTree.getCandidatePair().getPrompt().getTriggerTime() - lastMuon->getTriggerTime(), lastMuon->template Event<K>::getVisibleEnergy());
+
+  }
+
+  inline unsigned IsotopeRateFitter::getNumberOfCandidates() const{
+    
+    return candidates.size();
+
+  }
+
+  inline unsigned IsotopeRateFitter::getNumberOfCandidates(unsigned energyClass) const{
+    
+    return std::count_if(candidates.begin(), candidates.end(), [&](const auto& candidate){return candidate.energyClass == energyClass;});
+
+  }
+
+  inline void IsotopeRateFitter::clearCandidates(){
+    
+    candidates.clear();
+
+  }
+
+  inline void IsotopeRateFitter::clear(){
+    
+    clearCandidates();
+
+  }
+
+  inline std::vector<double> IsotopeRateFitter::getInitialValues() const{
+    
+    std::vector<double> initialValues(getNumberOfParameters());
+    for(unsigned k = 0; k < getNumberOfIsotopes(); ++k) initialValues[getLifetimeIndex(k)] = initialLifetimes[k];
+    for(unsigned energyClass = 0; energyClass < getNumberOfEnergyClasses(); ++energyClass){
+      
+      double numberOfCandidates = std::max(getNumberOfCandidates(energyClass), 1u);
+      for(unsigned k = 0; k < getNumberOfIsotopes(); ++k) initialValues[getSignalYieldIndex(k, energyClass)] = 0.1 * numberOfCandidates / getNumberOfIsotopes();
+      initialValues[getBackgroundYieldIndex(energyClass)] = (getNumberOfIsotopes() > 0 ? 0.9 : 1) * numberOfCandidates;
+
+    }
+
+    return initialValues;
+
+  }
+
+  inline double IsotopeRateFitter::getMinusLogLikelihood(const std::vector<double>& parameters, std::vector<double>& gradient) const{
+    
+    if(parameters.size() != getNumberOfParameters()) throw std::invalid_argument(std::to_string(parameters.size())+" is not a valid number of parameters, "+std::to_string(getNumberOfParameters())+" are expected.");
+
+    gradient.assign(parameters.size(), 0);
+    if(!isValid(parameters)) return std::numeric_limits<double>::infinity();
+
+    auto numberOfChunks = (candidates.size() + chunkSize - 1) / chunkSize;
+    std::vector<double> chunkLikelihoods(numberOfChunks);
+    std::vector<std::vector<double>> chunkGradients(numberOfChunks, std::vector<double>(parameters.size(), 0));
+    if(numberOfChunks == 1 || pool.getNumberOfThreads() == 1) for(std::size_t k = 0; k < numberOfChunks; ++k) chunkLikelihoods[k] = getMinusLogLikelihood(parameters, chunkGradients[k], k * chunkSize, std::min((k + 1) * chunkSize, candidates.size()));
+    else{
+      
+      std::vector<std::function<void(unsigned)>> tasks;
+      for(std::size_t k = 0; k < numberOfChunks; ++k) tasks.emplace_back([&, k](unsigned){chunkLikelihoods[k] = getMinusLogLikelihood(parameters, chunkGradients[k], k * chunkSize, std::min((k + 1) * chunkSize, candidates.size()));});
+      pool.execute(std::move(tasks));
+
+    }
+
+    double minusLogLikelihood = 0;
+    for(std::size_t k = 0; k < numberOfChunks; ++k){
+      
+      minusLogLikelihood += chunkLikelihoods[k];
+      for(unsigned l = 0; l < parameters.size(); ++l) gradient[l] += chunkGradients[k][l];
+
+    }
+    if(!std::isfinite(minusLogLikelihood)) return std::numeric_limits<double>::infinity();
+
+    for(unsigned energyClass = 0; energyClass < getNumberOfEnergyClasses(); ++energyClass){//extended terms
+      
+      minusLogLikelihood += parameters[getBackgroundYieldIndex(energyClass)];
+      gradient[getBackgroundYieldIndex(energyClass)] += 1;
+      for(unsigned k = 0; k < getNumberOfIsotopes(); ++k){
+        
+        minusLogLikelihood += parameters[getSignalYieldIndex(k, energyClass)];
+        gradient[getSignalYieldIndex(k, energyClass)] += 1;
+
+      }
+
+    }
+
+    return minusLogLikelihood;
+
+  }
+
+  inline IsotopeRateFitter::Result IsotopeRateFitter::fit() const{
+    
+    return fit(getInitialValues());
+
+  }
+
+  inline IsotopeRateFitter::Result IsotopeRateFitter::fit(std::vector<double> initialValues, unsigned maxNumberOfIterations, double tolerance) const{
+    
+    std::vector<double> gradient;
+    double minusLogLikelihood = getMinusLogLikelihood(initialValues, gradient);
+    if(!std::isfinite(minusLogLikelihood)) throw std::invalid_argument("The initial values of the fit are outside of the physical region.");
+
+    std::vector<unsigned> freeIndices;
+    for(unsigned k = 0; k < initialValues.size(); ++k) if(k >= getNumberOfIsotopes() || !areLifetimesFixed[k]) freeIndices.push_back(k);
+    unsigned dimension = freeIndices.size();
+
+    auto inverseHessian = getHessian(initialValues, freeIndices);//the parameters have very different scales, so BFGS starts from the actual curvature
+    if(!invert(inverseHessian, dimension)){
+      
+      std::fill(inverseHessian.begin(), inverseHessian.end(), 0);
+      for(unsigned k = 0; k < dimension; ++k) inverseHessian[k * dimension + k] = 1e-2 * std::max(initialValues[freeIndices[k]] * initialValues[freeIndices[k]], 1.);
+
+    }
+
+    Result result{std::move(initialValues), std::vector<double>(getNumberOfParameters(), 0), minusLogLikelihood, 0, false};
+    auto& parameters = result.values;
+    std::vector<double> direction(dimension), newParameters, newGradient, step(dimension), gradientChange(dimension), inverseHessianChange(dimension);
+    for(; result.numberOfIterations < maxNumberOfIterations; ++result.numberOfIterations){
+      
+      double distanceToMinimum = 0;
+      for(unsigned k = 0; k < dimension; ++k){
+        
+        direction[k] = 0;
+        for(unsigned l = 0; l < dimension; ++l) direction[k] -= inverseHessian[k * dimension + l] * gradient[freeIndices[l]];
+        distanceToMinimum -= direction[k] * gradient[freeIndices[k]] / 2;
+
+      }
+      if(distanceToMinimum < tolerance){
+        
+        result.hasConverged = true;
+        break;
+
+      }
+
+      double stepLenght = 1, newMinusLogLikelihood = std::numeric_limits<double>::infinity();
+      for(unsigned trial = 0; trial < 40; ++trial, stepLenght /= 2){//backtracking until the Armijo condition holds
+        
+        newParameters = parameters;
+        for(unsigned k = 0; k < dimension; ++k) newParameters[freeIndices[k]] += stepLenght * direction[k];
+        newMinusLogLikelihood = getMinusLogLikelihood(newParameters, newGradient);
+        if(newMinusLogLikelihood <= minusLogLikelihood - 1e-4 * stepLenght * 2 * distanceToMinimum) break;
+
+      }
+      if(!(newMinusLogLikelihood < minusLogLikelihood)) break;//no progress possible
+
+      for(unsigned k = 0; k < dimension; ++k){
+        
+        step[k] = newParameters[freeIndices[k]] - parameters[freeIndices[k]];
+        gradientChange[k] = newGradient[freeIndices[k]] - gradient[freeIndices[k]];
+
+      }
+      auto curvature = std::inner_product(step.begin(), step.end(), gradientChange.begin(), 0.);
+      if(curvature > 0){//BFGS update of the inverse Hessian
+        
+        double gradientChangeNorm = 0;
+        for(unsigned k = 0; k < dimension; ++k){
+          
+          inverseHessianChange[k] = 0;
+          for(unsigned l = 0; l < dimension; ++l) inverseHessianChange[k] += inverseHessian[k * dimension + l] * gradientChange[l];
+          gradientChangeNorm += gradientChange[k] * inverseHessianChange[k];
+
+        }
+        for(unsigned k = 0; k < dimension; ++k) for(unsigned l = 0; l < dimension; ++l) inverseHessian[k * dimension + l] += ((curvature + gradientChangeNorm) * step[k] * step[l] / curvature - inverseHessianChange[k] * step[l] - step[k] * inverseHessianChange[l]) / curvature;
+
+      }
+
+      parameters = std::move(newParameters);
+      gradient = std::move(newGradient);
+      minusLogLikelihood = newMinusLogLikelihood;
+
+    }
+
+    result.minusLogLikelihood = minusLogLikelihood;
+    auto covariance = getHessian(parameters, freeIndices);
+    if(invert(covariance, dimension)) for(unsigned k = 0; k < dimension; ++k) result.errors[freeIndices[k]] = std::sqrt(covariance[k * dimension + k]);
+    else result.hasConverged = false;
+
+    return result;
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef COSMOGENIC_LATENCY_MONITOR_H
+#define COSMOGENIC_LATENCY_MONITOR_H
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace CosmogenicHunter{
+
+  class LatencyMonitor{//distribution of wall clock latencies on bins a factor 2 wide, cheap enough to record every emitted output
+
+    static constexpr unsigned numberOfBins = 48;//bin k holds [2^k, 2^(k+1)[ ns, the last one everything above
+    std::array<unsigned long long, numberOfBins> binContents;
+    unsigned long long numberOfRecords;
+    std::chrono::nanoseconds totalLatency;
+    std::chrono::nanoseconds maxLatency;
+    static unsigned getBinIndex(std::chrono::nanoseconds latency);
+
+  public:
+    LatencyMonitor();
+    void record(std::chrono::nanoseconds latency);
+    unsigned long long getNumberOfRecords() const;
+    std::chrono::nanoseconds getMeanLatency() const;
+    std::chrono::nanoseconds getMaxLatency() const;
+    std::chrono::nanoseconds getQuantile(double probability) const;//up edge of the bin holding the quantile (capped by the max), so at most twice the exact value
+    void clear();
+    LatencyMonitor& operator += (const LatencyMonitor& other);//e.g. to merge the monitors of several workers
+    void print(std::ostream& output, unsigned outputOffset) const;
+
+  };
+
+  inline unsigned LatencyMonitor::getBinIndex(std::chrono::nanoseconds latency){
+    
+    unsigned binIndex = 0;
+    for(auto count = latency.count(); count > 1 && binIndex + 1 < numberOfBins; count >>= 1) ++binIndex;
+    return binIndex;
+
+  }
+
+  inline LatencyMonitor::LatencyMonitor(){
+    
+    clear();
+
+  }
+
+  inline void LatencyMonitor::record(std::chrono::nanoseconds latency){
+    
+    latency = std::max(latency, std::chrono::nanoseconds(0));//clocks of different hosts may disagree
+    ++binContents[getBinIndex(latency)];
+    ++numberOfRecords;
+    totalLatency += latency;
+    maxLatency = std::max(maxLatency, latency);
+
+  }
+
+  inline unsigned long long LatencyMonitor::getNumberOfRecords() const{
+    
+    return numberOfRecords;
+
+  }
+
+  inline std::chrono::nanoseconds LatencyMonitor::getMeanLatency() const{
+    
+    return numberOfRecords > 0 ? totalLatency / static_cast<std::chrono::nanoseconds::rep>(numberOfRecords) : std::chrono::nanoseconds(0);
+
+  }
+
+  inline std::chrono::nanoseconds LatencyMonitor::getMaxLatency() const{
+    
+    return maxLatency;
+
+  }
+
+  inline std::chrono::nanoseconds LatencyMonitor::getQuantile(double probability) const{
+    
+    if(probability < 0 || probability > 1) throw std::invalid_argument(std::to_string(probability)+" is not a valid probability.");
+    if(numberOfRecords == 0) return std::chrono::nanoseconds(0);
+
+    unsigned long long cumulatedContent = 0;
+    for(unsigned k = 0; k < numberOfBins; ++k){
+      
+      cumulatedContent += binContents[k];
+      if(cumulatedContent >= probability * numberOfRecords && cumulatedContent > 0) return std::min(std::chrono::nanoseconds(std::int64_t(2) << k), maxLatency);
+
+    }
+
+    return maxLatency;
+
+  }
+
+  inline void LatencyMonitor::clear(){
+    
+    binContents.fill(0);
+    numberOfRecords = 0;
+    totalLatency = std::chrono::nanoseconds(0);
+    maxLatency = std::chrono::nanoseconds(0);
+
+  }
+
+  inline LatencyMonitor& LatencyMonitor::operator += (const LatencyMonitor& other){
+    
+    for(unsigned k = 0; k < numberOfBins; ++k) binContents[k] += other.binContents[k];
+    numberOfRecords += other.numberOfRecords;
+    totalLatency += other.totalLatency;
+    maxLatency = std::max(maxLatency, other.maxLatency);
+    return *this;
+
+  }
+
+  inline void LatencyMonitor::print(std::ostream& output, unsigned outputOffset) const{
+    
+    auto toMicroseconds = [](std::chrono::nanoseconds latency){return std::chrono::duration<double, std::micro>(latency).count();};
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(10)<<std::left<<"Records: "<<numberOfRecords<<"\n";
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(10)<<std::left<<"Mean: "<<toMicroseconds(getMeanLatency())<<"us\n";
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(10)<<std::left<<"Median: "<<toMicroseconds(getQuantile(0.5))<<"us\n";
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(10)<<std::left<<"99%: "<<toMicroseconds(getQuantile(0.99))<<"us\n";
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(10)<<std::left<<"Max: "<<toMicroseconds(getMaxLatency())<<"us";
+
+  }
+
+  inline std::ostream& operator<<(std::ostream& output, const LatencyMonitor& latencyMonitor){
+    
+    latencyMonitor.print(output, 0);
+    return output;
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef COSMOGENIC_LAZY_CANDIDATE_TREE_H
+#define COSMOGENIC_LAZY_CANDIDATE_TREE_H
+
+#include "Cosmogenic/CandidateTree.hpp"
+#include "Cosmogenic/EventStore.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T, class K>
+  class LazyCandidateTree{//CandidateTree whose muon showers are only built, from shared event stores, when first accessed
+    
+    CandidatePair<T> candidatePair;
+    std::shared_ptr<const EventStore<Muon<K>>> muons;
+    std::shared_ptr<const EventStore<Single<T>>> singles;//followers, may be null to build showers without followers
+    Bounds<TriggerTime> muonTimeBounds;//muons of the history, later events are ignored (followers included)
+    Bounds<TriggerTime> followerTimeBounds;//relative to each muon
+    mutable std::unique_ptr<SharedWindow<Shower<Muon<K>, Single<T>>>> muonShowers;//not thread safe: concurrent first accesses must be synchronised by the caller
+    void materialize() const;
+    
+  public:
+    LazyCandidateTree() = default;
+    LazyCandidateTree(CandidatePair<T> candidatePair, std::shared_ptr<const EventStore<Muon<K>>> muons, std::shared_ptr<const EventStore<Single<T>>> singles, Bounds<TriggerTime> muonTimeBounds, Bounds<TriggerTime> followerTimeBounds);
+    LazyCandidateTree(const LazyCandidateTree<T,K>& other);
+    LazyCandidateTree(LazyCandidateTree<T,K>&& other) = default;
+    LazyCandidateTree<T,K>& operator = (const LazyCandidateTree<T,K>& other);
+    LazyCandidateTree<T,K>& operator = (LazyCandidateTree<T,K>&& other) = default;
+    ~LazyCandidateTree() = default;
+    const CandidatePair<T>& getCandidatePair() const;
+    const Bounds<TriggerTime>& getMuonTimeBounds() const;
+    bool isMaterialized() const;
+    const SharedWindow<Shower<Muon<K>, Single<T>>>& getMuonShowers() const;//builds the showers on first access
+    const Muon<K>* getLastMuon() const;//nullptr if there is no muon in the history
+    TriggerTime getTimeCorrelationToLastMuon() const;//does not build the showers
+    bool isAfterMuon(TriggerTime afterMuonTimeVeto) const;//does not build the showers
+    CandidateTree<T,K> getCandidateTree() const;//e.g. to serialize the tree
+    
+  };
+  
+  template <class T, class K>
+  void LazyCandidateTree<T,K>::materialize() const{
+    
+    auto window = std::make_unique<SharedWindow<Shower<Muon<K>, Single<T>>>>(muonTimeBounds.getLowEdge(), muonTimeBounds.getWidth());
+    
+    if(muons){
+      
+      auto muonRange = muons->getRange(muonTimeBounds);
+      for(auto itMuon = muonRange.first; itMuon != muonRange.second; ++itMuon){
+        
+        Shower<Muon<K>, Single<T>> shower(*itMuon, followerTimeBounds);
+        if(singles){
+          
+          auto followerBounds = shift(followerTimeBounds, itMuon->getTriggerTime());
+          auto followerUpEdge = std::min(followerBounds.getUpEdge(), muonTimeBounds.getUpEdge());//singles read after the history are ignored
+          
+          auto followerRange = singles->getRange(Bounds<TriggerTime>(std::min(followerBounds.getLowEdge(), followerUpEdge), followerUpEdge));
+          for(auto itFollower = followerRange.first; itFollower != followerRange.second; ++itFollower) shower.pushBackFollower(*itFollower);
+          
+        }
+        window->pushBackEvent(std::move(shower));
+        
+      }
+      
+    }
+    
+    muonShowers = std::move(window);
+
+  }
+  
+  template <class T, class K>
+  LazyCandidateTree<T,K>::LazyCandidateTree(CandidatePair<T> candidatePair, std::shared_ptr<const EventStore<Muon<K>>> muons, std::shared_ptr<const EventStore<Single<T>>> singles, Bounds<TriggerTime> muonTimeBounds, Bounds<TriggerTime> followerTimeBounds)
+  :candidatePair(std::move(candidatePair)),muons(std::move(muons)),singles(std::move(singles)),muonTimeBounds(std::move(muonTimeBounds)),followerTimeBounds(std::move(followerTimeBounds)){
+    
+  }
+  
+  template <class T, class K>
+  LazyCandidateTree<T,K>::LazyCandidateTree(const LazyCandidateTree<T,K>& other)
+  :candidatePair(other.candidatePair),muons(other.muons),singles(other.singles),muonTimeBounds(other.muonTimeBounds),followerTimeBounds(other.followerTimeBounds){
+    
+    if(other.muonShowers) muonShowers = std::make_unique<SharedWindow<Shower<Muon<K>, Single<T>>>>(*other.muonShowers);//O(1), the showers are shared
+    
+  }
+  
+  template <class T, class K>
+  LazyCandidateTree<T,K>& LazyCandidateTree<T,K>::operator = (const LazyCandidateTree<T,K>& other){
+    
+    if(this != &other) *this = LazyCandidateTree<T,K>(other);
+    return *this;
+    
+  }
+  
+  template <class T, class K>
+  const CandidatePair<T>& LazyCandidateTree<T,K>::getCandidatePair() const{
+    
+    return candidatePair;
+
+  }
+  
+  template <class T, class K>
+  const Bounds<TriggerTime>& LazyCandidateTree<T,K>::getMuonTimeBounds() const{
+    
+    return muonTimeBounds;
+
+  }
+  
+  template <class T, class K>
+  bool LazyCandidateTree<T,K>::isMaterialized() const{
+    
+    return muonShowers != nullptr;
+
+  }
+  
+  template <class T, class K>
+  const SharedWindow<Shower<Muon<K>, Single<T>>>& LazyCandidateTree<T,K>::getMuonShowers() const{
+    
+    if(!muonShowers) materialize();
+    return *muonShowers;
+
+  }
+  
+  template <class T, class K>
+  const Muon<K>* LazyCandidateTree<T,K>::getLastMuon() const{
+    
+    if(!muons) return nullptr;
+    
+    auto lastMuon = muons->getLastBefore(muonTimeBounds.getUpEdge());
+    if(lastMuon != nullptr && muonTimeBounds.contains(lastMuon->getTriggerTime())) return lastMuon;
+    else return nullptr;
+
+  }
+  
+  template <class T, class K>
+  TriggerTime LazyCandidateTree<T,K>::getTimeCorrelationToLastMuon() const{
+    
+    auto lastMuon = getLastMuon();
+    if(lastMuon == nullptr) throw std::out_of_range("There is no muon in the history of the candidate.");
+    return CosmogenicHunter::getTimeCorrelation(candidatePair.getPrompt(), *lastMuon);
+
+  }
+  
+  template <class T, class K>
+  bool LazyCandidateTree<T,K>::isAfterMuon(TriggerTime afterMuonTimeVeto) const{
+    
+    return getLastMuon() != nullptr && getTimeCorrelationToLastMuon() < afterMuonTimeVeto;
+
+  }
+  
+  template <class T, class K>
+  CandidateTree<T,K> LazyCandidateTree<T,K>::getCandidateTree() const{
+    
+    return CandidateTree<T,K>(candidatePair, getMuonShowers());
+
+  }
+  
+  template <class T, class K>
+  std::ostream& operator<<(std::ostream& output, const LazyCandidateTree<T,K>& lazyCandidateTree){
+    
+    output<<lazyCandidateTree.getCandidateTree();
+    return output;
+    
+  }
+
+}
+
+#endif
@@ -7,6 +7,9 @@
 #include "Cosmogenic/Veto.hpp"
 
 namespace CosmogenicHunter{
+
+  template <class T>
+  struct ChargeData;
   
   template <class T>
   class LightNoiseVeto : public Veto<T>{
@@ -0,0 +1,164 @@
+#ifndef COSMOGENIC_LIVETIME_CALCULATOR_H
+#define COSMOGENIC_LIVETIME_CALCULATOR_H
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/Bounds.hpp"
+#include "Cosmogenic/Muon.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class LivetimeCalculator{//union of the time intervals vetoed after each muon, built incrementally from the muon stream
+    
+    struct DeadInterval{
+      
+      TriggerTime startTime;
+      TriggerTime endTime;
+      TriggerTime previousDeadTime;//total length of the previous intervals
+      template <class Archive>
+      void serialize(Archive& archive);
+
+    };
+
+    std::function<TriggerTime(const Muon<T>&)> getVetoDuration;
+    std::vector<DeadInterval> deadIntervals;//disjoint and time ordered, only the last one can still grow
+    friend class cereal::access;
+    template <class Archive>
+    void serialize(Archive& archive, std::uint32_t version);//the veto durations are kept
+    TriggerTime getDeadTimeBefore(TriggerTime triggerTime) const;
+
+  public:
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(1);
+    explicit LivetimeCalculator(TriggerTime vetoDuration);
+    explicit LivetimeCalculator(std::function<TriggerTime(const Muon<T>&)> getVetoDuration);//e.g. longer after showering muons, using MuonDefinition::getVisibleEnergy
+    unsigned getNumberOfDeadIntervals() const;
+    void addMuon(const Muon<T>& muon);//muons must come in time order, O(1)
+    void addDeadInterval(TriggerTime startTime, TriggerTime duration);//same, for any other source of dead time
+    bool isDead(TriggerTime triggerTime) const;//O(log n)
+    TriggerTime getDeadTime() const;//O(1)
+    TriggerTime getDeadTime(const Bounds<TriggerTime>& timeBounds) const;//exact, O(log n)
+    TriggerTime getLiveTime(const Bounds<TriggerTime>& timeBounds) const;//e.g. the bounds of the run
+    double getDeadTimeFraction(const Bounds<TriggerTime>& timeBounds) const;
+    void clear();//e.g. between runs
+
+  };
+
+  template <class T>
+  template <class Archive>
+  void LivetimeCalculator<T>::DeadInterval::serialize(Archive& archive){
+    
+    archive(startTime, endTime, previousDeadTime);
+
+  }
+
+  template <class T>
+  template <class Archive>
+  void LivetimeCalculator<T>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(deadIntervals);
+    else throw std::runtime_error(getUnknownVersionMessage<LivetimeCalculator<T>>("LivetimeCalculator", version));
+
+  }
+
+  template <class T>
+  TriggerTime LivetimeCalculator<T>::getDeadTimeBefore(TriggerTime triggerTime) const{
+    
+    auto itNext = std::upper_bound(deadIntervals.begin(), deadIntervals.end(), triggerTime, [](TriggerTime time, const auto& deadInterval){return time < deadInterval.startTime;});
+    if(itNext == deadIntervals.begin()) return 0;
+
+    const auto& deadInterval = *std::prev(itNext);
+    return deadInterval.previousDeadTime + std::min(triggerTime, deadInterval.endTime) - deadInterval.startTime;
+
+  }
+
+  template <class T>
+  LivetimeCalculator<T>::LivetimeCalculator(TriggerTime vetoDuration):LivetimeCalculator([vetoDuration](const Muon<T>&){return vetoDuration;}){
+    
+    if(vetoDuration < 0) throw std::invalid_argument(std::to_string(vetoDuration)+"ns is not a valid veto duration.");
+
+  }
+
+  template <class T>
+  LivetimeCalculator<T>::LivetimeCalculator(std::function<TriggerTime(const Muon<T>&)> getVetoDuration):getVetoDuration(std::move(getVetoDuration)){
+  
+  }
+
+  template <class T>
+  unsigned LivetimeCalculator<T>::getNumberOfDeadIntervals() const{
+    
+    return deadIntervals.size();
+
+  }
+
+  template <class T>
+  void LivetimeCalculator<T>::addMuon(const Muon<T>& muon){
+    
+    addDeadInterval(muon.getTriggerTime(), getVetoDuration(muon));
+
+  }
+
+  template <class T>
+  void LivetimeCalculator<T>::addDeadInterval(TriggerTime startTime, TriggerTime duration){
+    
+    if(duration <= 0) return;
+    if(!deadIntervals.empty() && startTime < deadIntervals.back().startTime) throw std::invalid_argument("Dead time starting at "+std::to_string(startTime)+"ns breaks the time ordering of the dead intervals.");
+
+    auto endTime = startTime + duration;
+    if(!deadIntervals.empty() && startTime <= deadIntervals.back().endTime) deadIntervals.back().endTime = std::max(deadIntervals.back().endTime, endTime);//the last interval ends after all the previous ones
+    else deadIntervals.push_back(DeadInterval{startTime, endTime, getDeadTime()});
+
+  }
+
+  template <class T>
+  bool LivetimeCalculator<T>::isDead(TriggerTime triggerTime) const{
+    
+    auto itNext = std::upper_bound(deadIntervals.begin(), deadIntervals.end(), triggerTime, [](TriggerTime time, const auto& deadInterval){return time < deadInterval.startTime;});
+    return itNext != deadIntervals.begin() && triggerTime < std::prev(itNext)->endTime;
+
+  }
+
+  template <class T>
+  TriggerTime LivetimeCalculator<T>::getDeadTime() const{
+    
+    if(deadIntervals.empty()) return 0;
+    else return deadIntervals.back().previousDeadTime + deadIntervals.back().endTime - deadIntervals.back().startTime;
+
+  }
+
+  template <class T>
+  TriggerTime LivetimeCalculator<T>::getDeadTime(const Bounds<TriggerTime>& timeBounds) const{
+    
+    return getDeadTimeBefore(timeBounds.getUpEdge()) - getDeadTimeBefore(timeBounds.getLowEdge());
+
+  }
+
+  template <class T>
+  TriggerTime LivetimeCalculator<T>::getLiveTime(const Bounds<TriggerTime>& timeBounds) const{
+    
+    return timeBounds.getWidth() - getDeadTime(timeBounds);
+
+  }
+
+  template <class T>
+  double LivetimeCalculator<T>::getDeadTimeFraction(const Bounds<TriggerTime>& timeBounds) const{
+    
+    if(timeBounds.getWidth() <= 0) throw std::invalid_argument("Cannot compute a dead time fraction over an empty time range.");
+    return static_cast<double>(getDeadTime(timeBounds)) / timeBounds.getWidth();
+
+  }
+
+  template <class T>
+  void LivetimeCalculator<T>::clear(){
+    
+    deadIntervals.clear();
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::LivetimeCalculator)
+
+#endif
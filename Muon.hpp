@@ -3,15 +3,13 @@
 
 #include "Cosmogenic/Event.hpp"
 #include "Cosmogenic/Segment.hpp"
+#include "Cosmogenic/Precision.hpp"
 
 namespace CosmogenicHunter{
 
   template <class T>
   class MuonDefinition;
   
-  template <class T>
-  class Single;
-  
   template <class T>
   class Muon : public Event<T>{
     
@@ -20,16 +18,20 @@ namespace CosmogenicHunter{
     T detectorCharge;
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned, see ClassVersion.hpp
     Muon() = default;
-    Muon(double triggerTime, T visibleEnergy, unsigned identifier, Segment<T> track, T vetoCharge, T detectorCharge);
+    Muon(TriggerTime triggerTime, T visibleEnergy, unsigned identifier, Segment<T> track, T vetoCharge, T detectorCharge);
     const Segment<T>& getTrack() const;
     T getVetoCharge() const;
     T getDetectorCharge() const;
     T getVisibleEnergy(const MuonDefinition<T>& muonDefinition) const;
-    T getDistanceTo(const Single<T>& single) const;//shortest distance between track and single's position
+    template <class Payload>
+    T getDistanceTo(const Single<T, Payload>& single) const;//shortest distance between track and single's position
     bool triggersInnerVeto(T maxInnerVetoCharge) const;
     void print(std::ostream& output, unsigned outputOffset) const;
     
@@ -37,14 +39,24 @@ namespace CosmogenicHunter{
   
   template <class T>
   template <class Archive>
-  void Muon<T>::serialize(Archive& archive){
+  void Muon<T>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(cereal::base_class<Event<T>>(this), track, vetoCharge, detectorCharge);
+    else throw std::runtime_error(getUnknownVersionMessage<Muon<T>>("Muon", version));
+
+  }
+  
+  template <class T>
+  template <class Archive>
+  void Muon<T>::loadUnversioned(Archive& archive){
     
-    archive(cereal::base_class<Event<T>>(this), track, vetoCharge, detectorCharge);
+    Event<T>::loadUnversioned(archive);
+    archive(track, vetoCharge, detectorCharge);
 
   }
   
   template <class T>
-  Muon<T>::Muon(double triggerTime, T visibleEnergy, unsigned identifier, Segment<T> track, T vetoCharge, T detectorCharge)
+  Muon<T>::Muon(TriggerTime triggerTime, T visibleEnergy, unsigned identifier, Segment<T> track, T vetoCharge, T detectorCharge)
   :Event<T>(triggerTime, visibleEnergy, identifier),track(std::move(track)),vetoCharge(vetoCharge),detectorCharge(detectorCharge){
     
   }
@@ -78,7 +90,8 @@ namespace CosmogenicHunter{
   }
   
   template <class T>
-  T Muon<T>::getDistanceTo(const Single<T>& single) const{
+  template <class Payload>
+  T Muon<T>::getDistanceTo(const Single<T, Payload>& single) const{
 
     return single.getDistanceTo(*this);
   
@@ -112,4 +125,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Muon)
+
 #endif
\ No newline at end of file
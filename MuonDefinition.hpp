@@ -4,6 +4,8 @@
 #include <iomanip>
 #include <stdexcept>
 #include <regex>
+#include <vector>
+#include <cstdint>
 
 namespace CosmogenicHunter{
 
@@ -38,8 +40,11 @@ namespace CosmogenicHunter{
     void setEnergyThreshold(T energyThreshold);
     void setIDChargeThreshold(T IDChargeThreshold);
     void setIDChargeToEnergyFactor(T IDChargeToEnergyFactor);
+    bool tag(T IVCharge, T IDCharge, T energy) const;
     bool tag(const Entry<T>& entry) const;
     bool tag(const Muon<T>& muon) const;
+    void tag(std::size_t numberOfEntries, const T* IVCharges, const T* IDCharges, const T* energies, std::uint8_t* muonMask) const;//columnar version of 'tag(T, T, T)', branchless so that compilers vectorise it
+    void tag(std::size_t numberOfEntries, const T* IVCharges, const T* IDCharges, const T* energies, std::uint8_t* muonMask, std::vector<std::size_t>& muonIndices) const;//also lists the indices of the muons
     T getVisibleEnergy(T IDCharge) const;
     T getVisibleEnergy(const Muon<T>& muon) const;
     T getIDCharge(T energy) const;
@@ -169,17 +174,53 @@ namespace CosmogenicHunter{
 
   }
   
+  template <class T>
+  bool MuonDefinition<T>::tag(T IVCharge, T IDCharge, T energy) const{
+
+    return IVCharge > IVChargeThreshold && (energy > energyThreshold || IDCharge > IDChargeThreshold);
+
+  }
+  
   template <class T>
   bool MuonDefinition<T>::tag(const Entry<T>& entry) const{
 
-    return entry.innerVetoData.charge[2] > IVChargeThreshold && ( entry.energy > energyThreshold || entry.innerDetectorData.charge[2] > IDChargeThreshold);
+    return tag(entry.innerVetoData.charge[2], entry.innerDetectorData.charge[2], entry.energy);
 
   }
   
   template <class T>
   bool MuonDefinition<T>::tag(const Muon<T>& muon) const{
 
-    return muon.getVetoCharge() > IVChargeThreshold && (muon.template Event<T>::getVisibleEnergy() > energyThreshold || muon.getDetectorCharge() > IDChargeThreshold);
+    return tag(muon.getVetoCharge(), muon.getDetectorCharge(), muon.template Event<T>::getVisibleEnergy());
+
+  }
+  
+  template <class T>
+  void MuonDefinition<T>::tag(std::size_t numberOfEntries, const T* IVCharges, const T* IDCharges, const T* energies, std::uint8_t* muonMask) const{
+    
+    auto IVChargeThreshold = this->IVChargeThreshold;//local copies: the mask may alias the members, which would forbid vectorisation
+    auto IDChargeThreshold = this->IDChargeThreshold;
+    auto energyThreshold = this->energyThreshold;
+    
+    for(std::size_t k = 0; k < numberOfEntries; ++k)
+      muonMask[k] = (IVCharges[k] > IVChargeThreshold) & ((energies[k] > energyThreshold) | (IDCharges[k] > IDChargeThreshold));
+
+  }
+  
+  template <class T>
+  void MuonDefinition<T>::tag(std::size_t numberOfEntries, const T* IVCharges, const T* IDCharges, const T* energies, std::uint8_t* muonMask, std::vector<std::size_t>& muonIndices) const{
+    
+    tag(numberOfEntries, IVCharges, IDCharges, energies, muonMask);
+    
+    muonIndices.resize(numberOfEntries);
+    std::size_t numberOfMuons = 0;
+    for(std::size_t k = 0; k < numberOfEntries; ++k){//branchless compaction
+      
+      muonIndices[numberOfMuons] = k;
+      numberOfMuons += muonMask[k];
+      
+    }
+    muonIndices.resize(numberOfMuons);
 
   }
   
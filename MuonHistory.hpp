@@ -0,0 +1,230 @@
+#ifndef COSMOGENIC_MUON_HISTORY_H
+#define COSMOGENIC_MUON_HISTORY_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "Cosmogenic/Muon.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class MuonHistory{//time-ordered muons indexed by a segment tree of their maximum visible energy and detector charge
+    
+    struct Aggregate{
+      
+      T maxVisibleEnergy;
+      T maxDetectorCharge;
+      
+    };
+    
+    std::vector<Muon<T>> muons;//muons before 'firstIndex' have been erased and wait for the next compaction
+    std::size_t firstIndex;
+    std::size_t capacity;//number of leaves, a power of 2
+    std::vector<Aggregate> nodes;//node k has children 2k and 2k+1, leaves start at 'capacity'
+    static Aggregate getEmptyAggregate();
+    static Aggregate merge(const Aggregate& aggregate1, const Aggregate& aggregate2);
+    static bool mayContain(const Aggregate& aggregate, T minVisibleEnergy, T minDetectorCharge);
+    void rebuild(std::size_t capacity);//compacts the muons and rebuilds all the nodes
+    void setLeaf(std::size_t index, const Aggregate& aggregate);
+    std::size_t getEndIndex(TriggerTime triggerTime) const;//first index at or after 'triggerTime'
+    long findLast(std::size_t node, std::size_t nodeLowIndex, std::size_t nodeUpIndex, std::size_t endIndex, T minVisibleEnergy, T minDetectorCharge) const;
+    long findLast(std::size_t endIndex, T minVisibleEnergy, T minDetectorCharge) const;//rightmost live index before 'endIndex' passing both thresholds, -1 if none
+    
+  public:
+    MuonHistory();
+    unsigned getNumberOfMuons() const;
+    bool isEmpty() const;
+    typename std::vector<Muon<T>>::const_iterator begin() const;
+    typename std::vector<Muon<T>>::const_iterator end() const;
+    void pushBackMuon(Muon<T> muon);//muons must come in time order
+    void eraseBefore(TriggerTime triggerTime);//forget the muons older than 'triggerTime'
+    void clear();
+    const Muon<T>* getLastMuonBefore(TriggerTime triggerTime) const;//nullptr if none
+    const Muon<T>* getLastMuonBefore(TriggerTime triggerTime, T minVisibleEnergy, T minDetectorCharge = std::numeric_limits<T>::lowest()) const;//O(log n) for a single threshold
+    const Muon<T>* getLastMuonBefore(TriggerTime triggerTime, const Point<T>& position, T maxDistance, T minVisibleEnergy = std::numeric_limits<T>::lowest()) const;//O(log n) per muon passing the energy threshold but too far from 'position'
+    template <class Payload>
+    const Muon<T>* getLastMuonBefore(const Single<T, Payload>& single, T maxDistance, T minVisibleEnergy = std::numeric_limits<T>::lowest()) const;
+    
+  };
+  
+  template <class T>
+  typename MuonHistory<T>::Aggregate MuonHistory<T>::getEmptyAggregate(){
+    
+    return Aggregate{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest()};
+
+  }
+  
+  template <class T>
+  typename MuonHistory<T>::Aggregate MuonHistory<T>::merge(const Aggregate& aggregate1, const Aggregate& aggregate2){
+    
+    return Aggregate{std::max(aggregate1.maxVisibleEnergy, aggregate2.maxVisibleEnergy), std::max(aggregate1.maxDetectorCharge, aggregate2.maxDetectorCharge)};
+
+  }
+  
+  template <class T>
+  bool MuonHistory<T>::mayContain(const Aggregate& aggregate, T minVisibleEnergy, T minDetectorCharge){
+    
+    return aggregate.maxVisibleEnergy >= minVisibleEnergy && aggregate.maxDetectorCharge >= minDetectorCharge;//necessary only: both maxima may come from different muons
+
+  }
+  
+  template <class T>
+  void MuonHistory<T>::rebuild(std::size_t capacity){
+    
+    muons.erase(muons.begin(), muons.begin() + firstIndex);
+    firstIndex = 0;
+    this->capacity = capacity;
+    
+    nodes.assign(2 * capacity, getEmptyAggregate());
+    for(std::size_t k = 0; k < muons.size(); ++k) nodes[capacity + k] = Aggregate{muons[k].template Event<T>::getVisibleEnergy(), muons[k].getDetectorCharge()};
+    for(std::size_t node = capacity - 1; node > 0; --node) nodes[node] = merge(nodes[2 * node], nodes[2 * node + 1]);
+
+  }
+  
+  template <class T>
+  void MuonHistory<T>::setLeaf(std::size_t index, const Aggregate& aggregate){
+    
+    auto node = capacity + index;
+    nodes[node] = aggregate;
+    for(node /= 2; node > 0; node /= 2) nodes[node] = merge(nodes[2 * node], nodes[2 * node + 1]);
+
+  }
+  
+  template <class T>
+  std::size_t MuonHistory<T>::getEndIndex(TriggerTime triggerTime) const{
+    
+    auto itFirstAfter = std::lower_bound(muons.begin() + firstIndex, muons.end(), triggerTime, [](const auto& muon, TriggerTime time){return muon.getTriggerTime() < time;});
+    return std::distance(muons.begin(), itFirstAfter);
+
+  }
+  
+  template <class T>
+  long MuonHistory<T>::findLast(std::size_t node, std::size_t nodeLowIndex, std::size_t nodeUpIndex, std::size_t endIndex, T minVisibleEnergy, T minDetectorCharge) const{
+    
+    if(nodeLowIndex >= endIndex || nodeUpIndex <= firstIndex || !mayContain(nodes[node], minVisibleEnergy, minDetectorCharge)) return -1;//erased leaves still pass lowest() thresholds, never descend before firstIndex
+    if(node >= capacity) return nodeLowIndex;//leaves are exact
+    
+    auto middleIndex = (nodeLowIndex + nodeUpIndex) / 2;
+    auto index = findLast(2 * node + 1, middleIndex, nodeUpIndex, endIndex, minVisibleEnergy, minDetectorCharge);
+    if(index >= 0) return index;
+    else return findLast(2 * node, nodeLowIndex, middleIndex, endIndex, minVisibleEnergy, minDetectorCharge);
+
+  }
+  
+  template <class T>
+  long MuonHistory<T>::findLast(std::size_t endIndex, T minVisibleEnergy, T minDetectorCharge) const{
+    
+    return findLast(1, 0, capacity, endIndex, minVisibleEnergy, minDetectorCharge);
+
+  }
+  
+  template <class T>
+  MuonHistory<T>::MuonHistory():firstIndex(0){
+    
+    rebuild(16);
+    
+  }
+  
+  template <class T>
+  unsigned MuonHistory<T>::getNumberOfMuons() const{
+    
+    return muons.size() - firstIndex;
+
+  }
+  
+  template <class T>
+  bool MuonHistory<T>::isEmpty() const{
+    
+    return getNumberOfMuons() == 0;
+
+  }
+  
+  template <class T>
+  typename std::vector<Muon<T>>::const_iterator MuonHistory<T>::begin() const{
+    
+    return muons.begin() + firstIndex;
+
+  }
+  
+  template <class T>
+  typename std::vector<Muon<T>>::const_iterator MuonHistory<T>::end() const{
+    
+    return muons.end();
+
+  }
+  
+  template <class T>
+  void MuonHistory<T>::pushBackMuon(Muon<T> muon){
+    
+    if(!isEmpty() && muon.getTriggerTime() < muons.back().getTriggerTime()) throw std::invalid_argument("Muon "+std::to_string(muon.getIdentifier())+" at "+std::to_string(muon.getTriggerTime())+"ns breaks the time ordering of the muon history.");
+    
+    if(muons.size() == capacity){
+      
+      if(2 * firstIndex >= capacity) rebuild(capacity);//erased muons free enough leaves
+      else rebuild(2 * capacity);
+      
+    }
+    
+    muons.push_back(std::move(muon));
+    setLeaf(muons.size() - 1, Aggregate{muons.back().template Event<T>::getVisibleEnergy(), muons.back().getDetectorCharge()});
+
+  }
+  
+  template <class T>
+  void MuonHistory<T>::eraseBefore(TriggerTime triggerTime){
+    
+    auto endIndex = getEndIndex(triggerTime);
+    for(; firstIndex < endIndex; ++firstIndex) setLeaf(firstIndex, getEmptyAggregate());
+
+  }
+  
+  template <class T>
+  void MuonHistory<T>::clear(){
+    
+    muons.clear();
+    firstIndex = 0;
+    rebuild(capacity);
+
+  }
+  
+  template <class T>
+  const Muon<T>* MuonHistory<T>::getLastMuonBefore(TriggerTime triggerTime) const{
+    
+    auto endIndex = getEndIndex(triggerTime);
+    if(endIndex > firstIndex) return &muons[endIndex - 1];
+    else return nullptr;
+
+  }
+  
+  template <class T>
+  const Muon<T>* MuonHistory<T>::getLastMuonBefore(TriggerTime triggerTime, T minVisibleEnergy, T minDetectorCharge) const{
+    
+    auto index = findLast(getEndIndex(triggerTime), minVisibleEnergy, minDetectorCharge);
+    if(index >= 0) return &muons[index];
+    else return nullptr;
+
+  }
+  
+  template <class T>
+  const Muon<T>* MuonHistory<T>::getLastMuonBefore(TriggerTime triggerTime, const Point<T>& position, T maxDistance, T minVisibleEnergy) const{
+    
+    long index = getEndIndex(triggerTime);
+    while((index = findLast(index, minVisibleEnergy, std::numeric_limits<T>::lowest())) >= 0)
+      if(muons[index].getTrack().getDistanceTo(position) < maxDistance) return &muons[index];
+    
+    return nullptr;
+
+  }
+  
+  template <class T>
+  template <class Payload>
+  const Muon<T>* MuonHistory<T>::getLastMuonBefore(const Single<T, Payload>& single, T maxDistance, T minVisibleEnergy) const{
+    
+    return getLastMuonBefore(single.getTriggerTime(), single.getPositionInformation().getPosition(), maxDistance, minVisibleEnergy);
+
+  }
+
+}
+
+#endif
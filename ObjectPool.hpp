@@ -0,0 +1,132 @@
+#ifndef COSMOGENIC_OBJECT_POOL_H
+#define COSMOGENIC_OBJECT_POOL_H
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class ObjectPool{//recycles objects (e.g. windows and showers, whose containers keep part of their memory when cleared) instead of destroying them, not thread safe: one pool per worker
+
+    struct Storage{//shared with the releasers, so that objects released after the pool are simply deleted
+      
+      std::vector<std::unique_ptr<T>> freeObjects;
+      std::function<void(T&)> recycle;//brings a released object back to a reusable state
+
+    };
+    
+    std::shared_ptr<Storage> storage;
+
+  public:
+    class Releaser{
+      
+      std::weak_ptr<Storage> storage;
+
+    public:
+      Releaser() = default;
+      explicit Releaser(std::weak_ptr<Storage> storage);
+      void operator()(T* object) const noexcept;//deletes the object if the pool is gone or if it cannot be recycled
+
+    };
+
+    using Handle = std::unique_ptr<T, Releaser>;//gives the object back to the pool when destroyed
+    explicit ObjectPool(std::function<void(T&)> recycle = [](T&){});
+    ObjectPool(const ObjectPool<T>& other);//an empty pool with the same recycling (e.g. when copying a worker state)
+    ObjectPool(ObjectPool<T>&& other) = delete;
+    ObjectPool<T>& operator = (const ObjectPool<T>& other) = delete;
+    ObjectPool<T>& operator = (ObjectPool<T>&& other) = delete;
+    ~ObjectPool() = default;
+    template <class... Args>
+    Handle acquire(Args&&... args);//a recycled object if there is one ('args' are then ignored), a new T(args...) otherwise
+    template <class... Args>
+    std::shared_ptr<T> acquireShared(Args&&... args);//same, given back to the pool by the last owner (e.g. a SharedWindow of showers and the trees sharing it), which must be on the thread of the pool
+    unsigned getNumberOfFreeObjects() const;
+    void release(std::unique_ptr<T> object);
+    void reserve(unsigned numberOfObjects);//builds default constructed objects ahead of time
+
+  };
+
+  template <class T>
+  ObjectPool<T>::Releaser::Releaser(std::weak_ptr<Storage> storage):storage(std::move(storage)){
+  
+  }
+
+  template <class T>
+  void ObjectPool<T>::Releaser::operator()(T* object) const noexcept{
+    
+    std::unique_ptr<T> owner(object);
+    auto lockedStorage = storage.lock();
+    if(!lockedStorage) return;
+    
+    try{
+      
+      lockedStorage->recycle(*owner);
+      lockedStorage->freeObjects.push_back(std::move(owner));
+      
+    }
+    catch(...){//a deleter must not throw, 'owner' deletes the object instead
+      
+    }
+
+  }
+
+  template <class T>
+  ObjectPool<T>::ObjectPool(std::function<void(T&)> recycle):storage(std::make_shared<Storage>()){
+    
+    storage->recycle = std::move(recycle);
+  
+  }
+
+  template <class T>
+  ObjectPool<T>::ObjectPool(const ObjectPool<T>& other):ObjectPool<T>(other.storage->recycle){
+  
+  }
+
+  template <class T>
+  template <class... Args>
+  typename ObjectPool<T>::Handle ObjectPool<T>::acquire(Args&&... args){
+    
+    auto& freeObjects = storage->freeObjects;
+    if(freeObjects.empty()) return Handle(new T(std::forward<Args>(args)...), Releaser(storage));
+
+    auto object = std::move(freeObjects.back());
+    freeObjects.pop_back();
+    return Handle(object.release(), Releaser(storage));
+
+  }
+
+  template <class T>
+  template <class... Args>
+  std::shared_ptr<T> ObjectPool<T>::acquireShared(Args&&... args){
+    
+    return std::shared_ptr<T>(acquire(std::forward<Args>(args)...));
+
+  }
+
+  template <class T>
+  unsigned ObjectPool<T>::getNumberOfFreeObjects() const{
+    
+    return storage->freeObjects.size();
+
+  }
+
+  template <class T>
+  void ObjectPool<T>::release(std::unique_ptr<T> object){
+    
+    storage->recycle(*object);
+    storage->freeObjects.push_back(std::move(object));
+
+  }
+
+  template <class T>
+  void ObjectPool<T>::reserve(unsigned numberOfObjects){
+    
+    while(storage->freeObjects.size() < numberOfObjects) storage->freeObjects.push_back(std::make_unique<T>());
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef COSMOGENIC_ONLINE_TREE_BUILDER_H
+#define COSMOGENIC_ONLINE_TREE_BUILDER_H
+
+#include <deque>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include "Cosmogenic/CandidateTree.hpp"
+#include "Cosmogenic/LatencyMonitor.hpp"
+#include "Cosmogenic/ObjectPool.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T, class K>
+  class OnlineTreeBuilder{//builds the CandidateTree's of the pairs keyed by their prompt from muons and singles as they arrive, and emits each one as soon as the watermark guarantees that no later event can change it
+
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Emitter = std::function<void(CandidateTree<T,K>)>;
+    using PairSelector = std::function<bool(const CandidatePair<T>&)>;
+
+  private:
+    struct BufferedSingle{
+      
+      Single<T> single;
+      Clock::time_point arrivalTime;
+
+    };
+
+    TriggerTime muonWindowLength;
+    Bounds<TriggerTime> followerTimeBounds;//relative to each muon
+    Bounds<TriggerTime> pairTimeBounds;//of the delayed relative to the prompt
+    TriggerTime maxWatermarkLag;//events older than the youngest one by more are late, so that a stalled input bounds neither the latency nor the memory
+    Emitter emitter;
+    PairSelector pairSelector;
+    std::deque<Muon<K>> pendingMuons;//not replayed yet
+    std::deque<BufferedSingle> singles;//the first 'numberOfReplayedSingles' are only kept as followers of the pending muons
+    unsigned numberOfReplayedSingles;
+    SharedWindow<Shower<Muon<K>, Single<T>>> muonShowers;//history as of the last replayed event, shared by the trees (copy-on-write)
+    ObjectPool<Shower<Muon<K>, Single<T>>>* showerPool;//null to allocate every shower
+    TriggerTime replayTime;//trigger time of the last replayed prompt
+    TriggerTime muonWatermark;//latest muon
+    TriggerTime singleWatermark;//latest single
+    TriggerTime latestTriggerTime;
+    unsigned long long numberOfLateMuons;
+    unsigned long long numberOfLateSingles;
+    unsigned long long numberOfEmittedTrees;
+    LatencyMonitor latencyMonitor;
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive, std::uint32_t version) const;
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t version);//keeps the emitter and the pair selector, the time windows must be the saved ones
+    bool isClosed(TriggerTime promptTime, TriggerTime watermark) const;//both the muon window and the pair window of the prompt
+    void replayMuon();//muons are only replayed by the next prompt, once the muon window has been moved
+    void replaySingle();//emits the trees of the single as a prompt, then adds it to the showers as a follower
+    void replay(bool force);//replays the pending events in time order, up to the first prompt that is not closed unless 'force'
+    void eraseUnneededSingles();
+
+  public:
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(1);//checkpoints are only resumed by the same build
+    OnlineTreeBuilder(TriggerTime muonWindowLength, Bounds<TriggerTime> followerTimeBounds, Bounds<TriggerTime> pairTimeBounds, Emitter emitter, PairSelector pairSelector = [](const CandidatePair<T>&){return true;}, TriggerTime maxWatermarkLag = std::numeric_limits<TriggerTime>::max());
+    TriggerTime getWatermark() const;//events older than the watermark are late
+    unsigned getNumberOfBufferedMuons() const;
+    unsigned getNumberOfBufferedSingles() const;
+    unsigned long long getNumberOfLateMuons() const;
+    unsigned long long getNumberOfLateSingles() const;
+    unsigned long long getNumberOfEmittedTrees() const;
+    const LatencyMonitor& getLatencyMonitor() const;//between the arrival of the youngest single of each tree and its emission
+    void pushMuon(Muon<K> muon);//muons must come in time order, late ones are dropped
+    void pushSingle(Single<T> single, Clock::time_point arrivalTime = Clock::now());//same for singles, 'arrivalTime' may be set upstream (e.g. when read from the DAQ)
+    void advanceWatermark(TriggerTime watermark);//heartbeat promising that no muon nor single older than 'watermark' will come, e.g. while one input is quiet
+    void flush();//end of run: emits all the pending trees and starts over
+    void setShowerPool(ObjectPool<Shower<Muon<K>, Single<T>>>* showerPool);//takes the showers from 'showerPool' (e.g. one per RunDriver worker, reused from run to run) and gives them back once no tree holds them, the trees must be destroyed on the thread of the pool
+
+  };
+
+  template <class T, class K>
+  template <class Archive>
+  void OnlineTreeBuilder<T,K>::save(Archive& archive, std::uint32_t) const{
+    
+    archive(muonWindowLength, followerTimeBounds.getLowEdge(), followerTimeBounds.getUpEdge(), pairTimeBounds.getLowEdge(), pairTimeBounds.getUpEdge(), maxWatermarkLag);
+    archive(pendingMuons, cereal::make_size_tag(static_cast<cereal::size_type>(singles.size())));
+    for(const auto& bufferedSingle : singles) archive(bufferedSingle.single);//arrival times are meaningless after a restart
+    archive(numberOfReplayedSingles, muonShowers, replayTime, muonWatermark, singleWatermark, latestTriggerTime, numberOfLateMuons, numberOfLateSingles, numberOfEmittedTrees);
+
+  }
+  
+  template <class T, class K>
+  template <class Archive>
+  void OnlineTreeBuilder<T,K>::load(Archive& archive, std::uint32_t version){
+    
+    if(version != serializationVersion) throw std::runtime_error(getUnknownVersionMessage<OnlineTreeBuilder<T,K>>("OnlineTreeBuilder", version));
+    
+    TriggerTime savedMuonWindowLength, savedFollowerLowEdge, savedFollowerUpEdge, savedPairLowEdge, savedPairUpEdge, savedMaxWatermarkLag;
+    archive(savedMuonWindowLength, savedFollowerLowEdge, savedFollowerUpEdge, savedPairLowEdge, savedPairUpEdge, savedMaxWatermarkLag);
+    if(savedMuonWindowLength != muonWindowLength || savedFollowerLowEdge != followerTimeBounds.getLowEdge() || savedFollowerUpEdge != followerTimeBounds.getUpEdge() || savedPairLowEdge != pairTimeBounds.getLowEdge() || savedPairUpEdge != pairTimeBounds.getUpEdge() || savedMaxWatermarkLag != maxWatermarkLag) throw std::runtime_error("The saved OnlineTreeBuilder was built with different time windows.");
+    
+    cereal::size_type numberOfSingles;
+    archive(pendingMuons, cereal::make_size_tag(numberOfSingles));
+    singles.clear();
+    auto arrivalTime = Clock::now();
+    for(cereal::size_type k = 0; k < numberOfSingles; ++k){
+      
+      singles.push_back(BufferedSingle{Single<T>(), arrivalTime});
+      archive(singles.back().single);
+      
+    }
+    archive(numberOfReplayedSingles, muonShowers, replayTime, muonWatermark, singleWatermark, latestTriggerTime, numberOfLateMuons, numberOfLateSingles, numberOfEmittedTrees);
+
+  }
+  
+  template <class T, class K>
+  bool OnlineTreeBuilder<T,K>::isClosed(TriggerTime promptTime, TriggerTime watermark) const{
+    
+    auto closingDelay = std::max(pairTimeBounds.getUpEdge(), TriggerTime(0));//muons come before the prompt, delayeds before the end of the pair window
+    return watermark >= std::numeric_limits<TriggerTime>::lowest() + closingDelay && promptTime <= watermark - closingDelay;
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::replayMuon(){
+    
+    if(showerPool){
+      
+      auto shower = showerPool->acquireShared();
+      shower->reset(std::move(pendingMuons.front()), followerTimeBounds);//keeps the memory of the follower window
+      pendingMuons.pop_front();
+      for(unsigned k = 0; k < numberOfReplayedSingles; ++k) shower->pushBackFollower(singles[k].single);
+      muonShowers.pushBackEvent(std::move(shower));
+      
+    }
+    else{
+      
+      Shower<Muon<K>, Single<T>> shower(std::move(pendingMuons.front()), followerTimeBounds);
+      pendingMuons.pop_front();
+      for(unsigned k = 0; k < numberOfReplayedSingles; ++k) shower.pushBackFollower(singles[k].single);//followers preceding the muon, the others are pushed when replayed
+      muonShowers.pushBackEvent(std::move(shower));//dropped if older than the muon window
+      
+    }
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::replaySingle(){
+    
+    const auto& prompt = singles[numberOfReplayedSingles];
+    replayTime = prompt.single.getTriggerTime();
+    muonShowers.setEndTime(replayTime);
+    while(!pendingMuons.empty() && pendingMuons.front().getTriggerTime() < replayTime) replayMuon();
+
+    auto emissionTime = Clock::now();
+    for(auto k = numberOfReplayedSingles + 1; k < singles.size(); ++k){
+      
+      const auto& delayed = singles[k];
+      auto timeCorrelation = delayed.single.getTriggerTime() - replayTime;
+      if(timeCorrelation >= pairTimeBounds.getUpEdge()) break;
+      if(!pairTimeBounds.contains(timeCorrelation)) continue;
+
+      CandidatePair<T> candidatePair(prompt.single, delayed.single);
+      if(!pairSelector(candidatePair)) continue;
+
+      emitter(CandidateTree<T,K>(std::move(candidatePair), muonShowers));//O(1), the showers are shared
+      latencyMonitor.record(emissionTime - std::max(prompt.arrivalTime, delayed.arrivalTime));
+      ++numberOfEmittedTrees;
+
+    }
+
+    muonShowers.modifyEventsIf([&](const auto& shower){return shower.getFollowerWindow().covers(prompt.single);}, [&](auto& shower){shower.pushBackFollower(prompt.single);});
+    ++numberOfReplayedSingles;
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::replay(bool force){
+    
+    auto watermark = getWatermark();
+    while(numberOfReplayedSingles < singles.size() && (force || isClosed(singles[numberOfReplayedSingles].single.getTriggerTime(), watermark))) replaySingle();
+
+    auto nextPromptTime = numberOfReplayedSingles < singles.size() ? singles[numberOfReplayedSingles].single.getTriggerTime() : watermark;//no later prompt can see the muons older than its muon window
+    if(nextPromptTime >= std::numeric_limits<TriggerTime>::lowest() + muonWindowLength)
+      while(!pendingMuons.empty() && pendingMuons.front().getTriggerTime() < nextPromptTime - muonWindowLength) pendingMuons.pop_front();
+
+    eraseUnneededSingles();
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::eraseUnneededSingles(){
+    
+    auto followerLowEdge = std::min(followerTimeBounds.getLowEdge(), TriggerTime(0));//the muons still to replay come at or after 'replayTime'
+    while(numberOfReplayedSingles > 0 && singles.front().single.getTriggerTime() - replayTime < followerLowEdge){
+      
+      singles.pop_front();
+      --numberOfReplayedSingles;
+
+    }
+
+  }
+
+  template <class T, class K>
+  OnlineTreeBuilder<T,K>::OnlineTreeBuilder(TriggerTime muonWindowLength, Bounds<TriggerTime> followerTimeBounds, Bounds<TriggerTime> pairTimeBounds, Emitter emitter, PairSelector pairSelector, TriggerTime maxWatermarkLag)
+  :muonWindowLength(muonWindowLength),followerTimeBounds(std::move(followerTimeBounds)),pairTimeBounds(std::move(pairTimeBounds)),maxWatermarkLag(maxWatermarkLag),emitter(std::move(emitter)),pairSelector(std::move(pairSelector)),numberOfReplayedSingles(0),muonShowers(0, muonWindowLength),showerPool(nullptr),replayTime(std::numeric_limits<TriggerTime>::lowest()),muonWatermark(std::numeric_limits<TriggerTime>::lowest()),singleWatermark(std::numeric_limits<TriggerTime>::lowest()),latestTriggerTime(std::numeric_limits<TriggerTime>::lowest()),numberOfLateMuons(0),numberOfLateSingles(0),numberOfEmittedTrees(0){
+    
+    if(muonWindowLength <= 0) throw std::invalid_argument(std::to_string(muonWindowLength)+"ns is not a valid muon window length.");
+    if(maxWatermarkLag < 0) throw std::invalid_argument(std::to_string(maxWatermarkLag)+"ns is not a valid watermark lag.");
+
+  }
+
+  template <class T, class K>
+  TriggerTime OnlineTreeBuilder<T,K>::getWatermark() const{
+    
+    auto watermark = std::min(muonWatermark, singleWatermark);
+    if(latestTriggerTime >= std::numeric_limits<TriggerTime>::lowest() + maxWatermarkLag) watermark = std::max(watermark, latestTriggerTime - maxWatermarkLag);
+    return watermark;
+
+  }
+
+  template <class T, class K>
+  unsigned OnlineTreeBuilder<T,K>::getNumberOfBufferedMuons() const{
+    
+    return pendingMuons.size() + muonShowers.getNumberOfEvents();
+
+  }
+
+  template <class T, class K>
+  unsigned OnlineTreeBuilder<T,K>::getNumberOfBufferedSingles() const{
+    
+    return singles.size();
+
+  }
+
+  template <class T, class K>
+  unsigned long long OnlineTreeBuilder<T,K>::getNumberOfLateMuons() const{
+    
+    return numberOfLateMuons;
+
+  }
+
+  template <class T, class K>
+  unsigned long long OnlineTreeBuilder<T,K>::getNumberOfLateSingles() const{
+    
+    return numberOfLateSingles;
+
+  }
+
+  template <class T, class K>
+  unsigned long long OnlineTreeBuilder<T,K>::getNumberOfEmittedTrees() const{
+    
+    return numberOfEmittedTrees;
+
+  }
+
+  template <class T, class K>
+  const LatencyMonitor& OnlineTreeBuilder<T,K>::getLatencyMonitor() const{
+    
+    return latencyMonitor;
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::pushMuon(Muon<K> muon){
+    
+    auto triggerTime = muon.getTriggerTime();
+    if(triggerTime < muonWatermark) throw std::invalid_argument("Muon "+std::to_string(muon.getIdentifier())+" at "+std::to_string(triggerTime)+"ns breaks the time ordering of the muons.");
+    if(triggerTime < getWatermark()){
+      
+      ++numberOfLateMuons;
+      return;
+
+    }
+
+    muonWatermark = triggerTime;
+    latestTriggerTime = std::max(latestTriggerTime, triggerTime);
+    pendingMuons.push_back(std::move(muon));
+    replay(false);
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::pushSingle(Single<T> single, Clock::time_point arrivalTime){
+    
+    auto triggerTime = single.getTriggerTime();
+    if(triggerTime < singleWatermark) throw std::invalid_argument("Single "+std::to_string(single.getIdentifier())+" at "+std::to_string(triggerTime)+"ns breaks the time ordering of the singles.");
+    if(triggerTime < getWatermark()){
+      
+      ++numberOfLateSingles;
+      return;
+
+    }
+
+    singleWatermark = triggerTime;
+    latestTriggerTime = std::max(latestTriggerTime, triggerTime);
+    singles.push_back(BufferedSingle{std::move(single), arrivalTime});
+    replay(false);
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::advanceWatermark(TriggerTime watermark){
+    
+    muonWatermark = std::max(muonWatermark, watermark);
+    singleWatermark = std::max(singleWatermark, watermark);
+    latestTriggerTime = std::max(latestTriggerTime, watermark);
+    replay(false);
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::flush(){
+    
+    replay(true);
+
+    pendingMuons.clear();
+    singles.clear();
+    numberOfReplayedSingles = 0;
+    muonShowers.clear();
+    replayTime = std::numeric_limits<TriggerTime>::lowest();
+    muonWatermark = std::numeric_limits<TriggerTime>::lowest();
+    singleWatermark = std::numeric_limits<TriggerTime>::lowest();
+    latestTriggerTime = std::numeric_limits<TriggerTime>::lowest();
+
+  }
+
+  template <class T, class K>
+  void OnlineTreeBuilder<T,K>::setShowerPool(ObjectPool<Shower<Muon<K>, Single<T>>>* showerPool){
+    
+    this->showerPool = showerPool;
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::OnlineTreeBuilder)
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef COSMOGENIC_PACKED_SINGLE_H
+#define COSMOGENIC_PACKED_SINGLE_H
+
+#include <array>
+#include <algorithm>
+#include "cereal/types/array.hpp"
+#include "Cosmogenic/Single.hpp"
+
+namespace CosmogenicHunter{
+
+  struct QuantizedField{//values in [lowEdge, upEdge] stored on 'numberOfBits' bits, values outside are clamped to the closest edge
+
+    double lowEdge;
+    double upEdge;
+    unsigned numberOfBits;
+    constexpr std::uint32_t getMaxCode() const;
+    std::uint32_t encode(double value) const;
+    double decode(std::uint32_t code) const;
+
+  };
+
+  struct DefaultSingleLayout{//ranges fitting the 20 bytes left beside the trigger time and identifier, define another layout with the same members to adapt them to the detector
+
+    static constexpr QuantizedField visibleEnergy{0, 80, 13};//MeV, 10 keV resolution
+    static constexpr QuantizedField position{-4000, 4000, 12};//mm, per coordinate
+    static constexpr QuantizedField positionInconsistency{0, 10, 8};
+    static constexpr QuantizedField innerVetoCharge{0, 50000, 10};//DUQ
+    static constexpr QuantizedField innerVetoNumberOfHitPMTs{0, 127, 7};//exact
+    static constexpr QuantizedField timeToInnerDetectorStart{-500, 500, 8};//ns
+    static constexpr QuantizedField distanceToInnerDetector{0, 8000, 8};//mm
+    static constexpr QuantizedField chargeRMS{0, 20000, 12};//DUQ
+    static constexpr QuantizedField chargeDifference{0, 20000, 12};//DUQ
+    static constexpr QuantizedField chargeRatio{0, 1, 12};
+    static constexpr QuantizedField startTimeRMS{0, 100, 12};//ns
+    static constexpr QuantizedField chimneyInconsistencyRatio{0, 10, 10};
+    static constexpr QuantizedField cosmogenicLikelihood{-32, 32, 12};//log likelihood ratio, see CosmogenicLikelihood, 0.016 resolution
+
+  };
+
+  template <class T, class Layout = DefaultSingleLayout>
+  class PackedSingle{//compact copy of a Single for large follower windows, fields are decoded on each access
+
+    enum Field : unsigned {visibleEnergy, x, y, z, positionInconsistency, innerVetoCharge, innerVetoNumberOfHitPMTs, timeToInnerDetectorStart, distanceToInnerDetector, chargeRMS, chargeDifference, chargeRatio, startTimeRMS, chimneyInconsistencyRatio, cosmogenicLikelihood, numberOfFields};
+    static constexpr std::array<QuantizedField, numberOfFields> fields{{Layout::visibleEnergy, Layout::position, Layout::position, Layout::position, Layout::positionInconsistency, Layout::innerVetoCharge, Layout::innerVetoNumberOfHitPMTs, Layout::timeToInnerDetectorStart, Layout::distanceToInnerDetector, Layout::chargeRMS, Layout::chargeDifference, Layout::chargeRatio, Layout::startTimeRMS, Layout::chimneyInconsistencyRatio, Layout::cosmogenicLikelihood}};
+    static constexpr unsigned getOffset(unsigned field){//first bit of 'field', defined here to size 'words'
+      
+      unsigned offset = 0;
+      for(unsigned k = 0; k < field; ++k) offset += fields[k].numberOfBits;
+      return offset;
+      
+    }
+    static constexpr unsigned numberOfWords = (getOffset(numberOfFields) + 31) / 32;
+
+    TriggerTime triggerTime;//kept exact
+    unsigned identifier;
+    std::array<std::uint32_t, numberOfWords> words;
+    friend class cereal::access;
+    template <class Archive>
+    void serialize(Archive& archive, std::uint32_t version);
+    T get(Field field) const;
+    void set(Field field, T value);
+
+  public:
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(3);//version 1 stored the default cosmogenic likelihood in [0, 1]
+    PackedSingle();
+    template <class Payload>
+    explicit PackedSingle(const Single<T, Payload>& single);
+    TriggerTime getTriggerTime() const;
+    unsigned getIdentifier() const;
+    T getVisibleEnergy() const;
+    PositionInformation<T> getPositionInformation() const;
+    InnerVetoInformation<T> getInnerVetoInformation() const;
+    ChargeInformation<T> getChargeInformation() const;
+    T getChimneyInconsistencyRatio() const;
+    T getCosmogenicLikelihood() const;
+    Single<T> unpack() const;//e.g. to hand the single to the vetoes
+    void shiftTriggerTime(TriggerTime timeShift);
+    void print(std::ostream& output, unsigned outputOffset) const;
+
+  };
+
+  constexpr std::uint32_t QuantizedField::getMaxCode() const{
+    
+    return numberOfBits == 32 ? 0xFFFFFFFF : (std::uint32_t(1) << numberOfBits) - 1;
+
+  }
+
+  inline std::uint32_t QuantizedField::encode(double value) const{
+    
+    auto clampedValue = std::min(std::max(value, lowEdge), upEdge);//also sends NaN's to 'lowEdge'
+    return static_cast<std::uint32_t>(std::lround((clampedValue - lowEdge) / (upEdge - lowEdge) * getMaxCode()));
+
+  }
+
+  inline double QuantizedField::decode(std::uint32_t code) const{
+    
+    return lowEdge + code * (upEdge - lowEdge) / getMaxCode();
+
+  }
+
+  template <class T, class Layout>
+  template <class Archive>
+  void PackedSingle<T, Layout>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(triggerTime, identifier, words);
+    else if(version == getForeignTriggerTimeVersion(3)){
+      
+      loadForeignTriggerTime(archive, triggerTime);
+      archive(identifier, words);
+
+    }
+    else if(version == getTriggerTimeVersion(1) || version == getForeignTriggerTimeVersion(1)){
+      
+      if(version == getTriggerTimeVersion(1)) archive(triggerTime);
+      else loadForeignTriggerTime(archive, triggerTime);
+      archive(identifier, words);
+      if(std::is_same<Layout, DefaultSingleLayout>::value){//re-encode with the signed range
+        
+        QuantizedField previousCosmogenicLikelihood{0, 1, 12};
+        auto offset = getOffset(cosmogenicLikelihood);
+        auto wordIndex = offset / 32;
+        std::uint64_t bits = words[wordIndex];
+        if(wordIndex + 1 < numberOfWords) bits |= std::uint64_t(words[wordIndex + 1]) << 32;
+        auto code = static_cast<std::uint32_t>(bits >> (offset % 32)) & previousCosmogenicLikelihood.getMaxCode();
+        set(cosmogenicLikelihood, static_cast<T>(previousCosmogenicLikelihood.decode(code)));
+        
+      }
+
+    }
+    else throw std::runtime_error(getUnknownVersionMessage<PackedSingle<T, Layout>>("PackedSingle", version));
+
+  }
+
+  template <class T, class Layout>
+  T PackedSingle<T, Layout>::get(Field field) const{
+    
+    auto offset = getOffset(field);
+    auto wordIndex = offset / 32;
+    std::uint64_t bits = words[wordIndex];
+    if(wordIndex + 1 < numberOfWords) bits |= std::uint64_t(words[wordIndex + 1]) << 32;//the field may straddle two words
+    auto code = static_cast<std::uint32_t>(bits >> (offset % 32)) & fields[field].getMaxCode();
+    return static_cast<T>(fields[field].decode(code));
+
+  }
+
+  template <class T, class Layout>
+  void PackedSingle<T, Layout>::set(Field field, T value){
+    
+    auto offset = getOffset(field);
+    auto wordIndex = offset / 32;
+    auto shift = offset % 32;
+    std::uint64_t mask = std::uint64_t(fields[field].getMaxCode()) << shift;
+    std::uint64_t code = std::uint64_t(fields[field].encode(value)) << shift;
+    words[wordIndex] = (words[wordIndex] & ~static_cast<std::uint32_t>(mask)) | static_cast<std::uint32_t>(code);
+    if(wordIndex + 1 < numberOfWords) words[wordIndex + 1] = (words[wordIndex + 1] & ~static_cast<std::uint32_t>(mask >> 32)) | static_cast<std::uint32_t>(code >> 32);
+
+  }
+
+  template <class T, class Layout>
+  PackedSingle<T, Layout>::PackedSingle():triggerTime(0),identifier(0),words{}{
+  
+  }
+
+  template <class T, class Layout>
+  template <class Payload>
+  PackedSingle<T, Layout>::PackedSingle(const Single<T, Payload>& single):triggerTime(single.getTriggerTime()),identifier(single.getIdentifier()),words{}{
+    
+    const auto& position = single.getPositionInformation().getPosition();
+    const auto& innerVetoInformation = single.getInnerVetoInformation();
+    const auto& chargeInformation = single.getChargeInformation();
+    set(visibleEnergy, single.getVisibleEnergy());
+    set(x, position.getX());
+    set(y, position.getY());
+    set(z, position.getZ());
+    set(positionInconsistency, single.getPositionInformation().getInconsistency());
+    set(innerVetoCharge, innerVetoInformation.getCharge());
+    set(innerVetoNumberOfHitPMTs, innerVetoInformation.getNumberOfHitPMTs());
+    set(timeToInnerDetectorStart, innerVetoInformation.getTimeToInnerDetectorStart());
+    set(distanceToInnerDetector, innerVetoInformation.getDistanceToInnerDetector());
+    set(chargeRMS, chargeInformation.getRMS());
+    set(chargeDifference, chargeInformation.getDifference());
+    set(chargeRatio, chargeInformation.getRatio());
+    set(startTimeRMS, chargeInformation.getStartTimeRMS());
+    set(chimneyInconsistencyRatio, single.getChimneyInconsistencyRatio());
+    set(cosmogenicLikelihood, single.getCosmogenicLikelihood());
+
+  }
+
+  template <class T, class Layout>
+  TriggerTime PackedSingle<T, Layout>::getTriggerTime() const{
+    
+    return triggerTime;
+
+  }
+
+  template <class T, class Layout>
+  unsigned PackedSingle<T, Layout>::getIdentifier() const{
+    
+    return identifier;
+
+  }
+
+  template <class T, class Layout>
+  T PackedSingle<T, Layout>::getVisibleEnergy() const{
+    
+    return get(visibleEnergy);
+
+  }
+
+  template <class T, class Layout>
+  PositionInformation<T> PackedSingle<T, Layout>::getPositionInformation() const{
+    
+    return PositionInformation<T>(Point<T>(get(x), get(y), get(z)), get(positionInconsistency));
+
+  }
+
+  template <class T, class Layout>
+  InnerVetoInformation<T> PackedSingle<T, Layout>::getInnerVetoInformation() const{
+    
+    return InnerVetoInformation<T>(get(innerVetoCharge), static_cast<unsigned short>(std::lround(get(innerVetoNumberOfHitPMTs))), get(timeToInnerDetectorStart), get(distanceToInnerDetector));
+
+  }
+
+  template <class T, class Layout>
+  ChargeInformation<T> PackedSingle<T, Layout>::getChargeInformation() const{
+    
+    return ChargeInformation<T>(get(chargeRMS), get(chargeDifference), get(chargeRatio), get(startTimeRMS));
+
+  }
+
+  template <class T, class Layout>
+  T PackedSingle<T, Layout>::getChimneyInconsistencyRatio() const{
+    
+    return get(chimneyInconsistencyRatio);
+
+  }
+
+  template <class T, class Layout>
+  T PackedSingle<T, Layout>::getCosmogenicLikelihood() const{
+    
+    return get(cosmogenicLikelihood);
+
+  }
+
+  template <class T, class Layout>
+  Single<T> PackedSingle<T, Layout>::unpack() const{
+    
+    return Single<T>(triggerTime, getVisibleEnergy(), identifier, getPositionInformation(), getInnerVetoInformation(), getChargeInformation(), getChimneyInconsistencyRatio(), getCosmogenicLikelihood());
+
+  }
+
+  template <class T, class Layout>
+  void PackedSingle<T, Layout>::shiftTriggerTime(TriggerTime timeShift){
+    
+    triggerTime += timeShift;
+
+  }
+
+  template <class T, class Layout>
+  void PackedSingle<T, Layout>::print(std::ostream& output, unsigned outputOffset) const{
+    
+    unpack().print(output, outputOffset);
+
+  }
+
+  template <class T, class Layout>
+  std::ostream& operator<<(std::ostream& output, const PackedSingle<T, Layout>& packedSingle){
+    
+    packedSingle.print(output, 0);
+    return output;
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::PackedSingle)
+
+#endif
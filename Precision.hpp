@@ -0,0 +1,17 @@
+#ifndef COSMOGENIC_PRECISION_H
+#define COSMOGENIC_PRECISION_H
+
+namespace CosmogenicHunter{
+
+  //precision policy of the singles: 'T' is used for the trigger time independent critical fields (energy, position, inner veto charge) and the veto thresholds
+  //'Payload' for the bulk fields only read by the vetoes (charge information, chimney inconsistency ratio, cosmogenic likelihood)
+  //any type convertible to and from T may be used as payload, e.g. a half precision floating point type
+  template <class T, class Payload = T>
+  class Single;
+
+  template <class T>
+  using MixedPrecisionSingle = Single<T, float>;//halves the memory of the payload of double precision singles kept in large windows
+
+}
+
+#endif
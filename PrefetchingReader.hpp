@@ -0,0 +1,171 @@
+#ifndef COSMOGENIC_PREFETCHING_READER_H
+#define COSMOGENIC_PREFETCHING_READER_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+namespace CosmogenicHunter{
+
+  template <class Event>
+  class PrefetchingReader{//decodes batches of events on a background thread while the caller processes the previous ones
+    
+    std::function<bool(Event&)> reader;//fills the event and returns false once the input is exhausted (only called from the background thread)
+    std::size_t batchSize;
+    std::mutex mutex;//guards the queues and the flags below, taken once per batch
+    std::condition_variable batchFilled;//wakes the caller waiting for events
+    std::condition_variable batchEmptied;//wakes the background thread waiting for a batch to fill
+    std::deque<std::vector<Event>> filledBatches;//background thread -> caller, never holds an empty batch
+    std::deque<std::vector<Event>> emptyBatches;//caller -> background thread, so that batches (and their events) are recycled instead of reallocated
+    std::vector<Event> currentBatch;
+    std::size_t currentIndex;
+    bool stopRequested;
+    bool inputExhausted;
+    std::exception_ptr readerException;//rethrown to the caller
+    std::thread backgroundThread;
+    void prefetch();
+    bool fetchNextBatch();//blocks until a batch is filled, returns false once the input is exhausted
+    
+  public:
+    PrefetchingReader(std::function<bool(Event&)> reader, std::size_t batchSize = 4096, std::size_t numberOfBatches = 4);
+    PrefetchingReader(const PrefetchingReader<Event>& other) = delete;
+    PrefetchingReader<Event>& operator = (const PrefetchingReader<Event>& other) = delete;
+    ~PrefetchingReader();
+    std::size_t getBatchSize() const;
+    bool read(Event& event);//same contract as 'reader', so that it can feed an EventStream
+    
+  };
+  
+  template <class Event>
+  void PrefetchingReader<Event>::prefetch(){
+    
+    try{
+      
+      bool hasMoreEvents = true;
+      while(hasMoreEvents){
+        
+        std::vector<Event> batch;
+        {
+          
+          std::unique_lock<std::mutex> lock(mutex);
+          batchEmptied.wait(lock, [&](){return stopRequested || !emptyBatches.empty();});//sleeps while the caller holds all the batches
+          if(stopRequested) return;
+          batch = std::move(emptyBatches.front());
+          emptyBatches.pop_front();
+          
+        }
+        
+        batch.resize(batchSize);
+        std::size_t numberOfEvents = 0;
+        while(numberOfEvents < batchSize && (hasMoreEvents = reader(batch[numberOfEvents]))) ++numberOfEvents;
+        batch.resize(numberOfEvents);
+        if(numberOfEvents == 0) break;//the input ended at a batch boundary
+        
+        {
+          
+          std::lock_guard<std::mutex> lock(mutex);
+          filledBatches.push_back(std::move(batch));
+          
+        }
+        batchFilled.notify_one();
+        
+      }
+      
+    }
+    catch(...){
+      
+      std::lock_guard<std::mutex> lock(mutex);
+      readerException = std::current_exception();
+      
+    }
+    
+    {
+      
+      std::lock_guard<std::mutex> lock(mutex);
+      inputExhausted = true;
+      
+    }
+    batchFilled.notify_one();
+
+  }
+  
+  template <class Event>
+  bool PrefetchingReader<Event>::fetchNextBatch(){
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    if(currentBatch.capacity() > 0){
+      
+      emptyBatches.push_back(std::move(currentBatch));
+      batchEmptied.notify_one();
+      
+    }
+    
+    currentIndex = 0;
+    currentBatch.clear();
+    batchFilled.wait(lock, [&](){return !filledBatches.empty() || inputExhausted;});
+    if(filledBatches.empty()){//the batches filled before the end of the input are all read
+      
+      if(readerException) std::rethrow_exception(readerException);
+      return false;
+      
+    }
+    
+    currentBatch = std::move(filledBatches.front());
+    filledBatches.pop_front();
+    return true;
+
+  }
+  
+  template <class Event>
+  PrefetchingReader<Event>::PrefetchingReader(std::function<bool(Event&)> reader, std::size_t batchSize, std::size_t numberOfBatches)
+  :reader(std::move(reader)),batchSize(batchSize),emptyBatches(numberOfBatches),currentIndex(0),stopRequested(false),inputExhausted(false){
+    
+    if(batchSize == 0 || numberOfBatches == 0) throw std::invalid_argument("Cannot prefetch empty batches of events.");
+    
+    for(auto& batch : emptyBatches) batch.reserve(batchSize);
+    
+    backgroundThread = std::thread(&PrefetchingReader<Event>::prefetch, this);
+    
+  }
+  
+  template <class Event>
+  PrefetchingReader<Event>::~PrefetchingReader(){
+    
+    {
+      
+      std::lock_guard<std::mutex> lock(mutex);
+      stopRequested = true;
+      
+    }
+    batchEmptied.notify_one();
+    if(backgroundThread.joinable()) backgroundThread.join();
+
+  }
+  
+  template <class Event>
+  std::size_t PrefetchingReader<Event>::getBatchSize() const{
+    
+    return batchSize;
+
+  }
+  
+  template <class Event>
+  bool PrefetchingReader<Event>::read(Event& event){
+    
+    while(currentIndex == currentBatch.size())
+      if(!fetchNextBatch()) return false;
+    
+    event = std::move(currentBatch[currentIndex]);
+    ++currentIndex;
+    return true;
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef COSMOGENIC_RUN_ARENA_H
+#define COSMOGENIC_RUN_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace CosmogenicHunter{
+
+  class RunArena{//memory for the windows, showers and candidate trees of one run, everything is freed at once by 'reset'
+
+    class UpstreamResource : public std::pmr::memory_resource{//counts what did not fit in the buffer
+
+      std::size_t allocatedBytes = 0;
+      void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+      void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+      std::size_t getAllocatedBytes() const;
+      void resetAllocatedBytes();
+
+    };
+
+    std::vector<std::byte> buffer;//grown to the peak usage of the previous runs, so that steady state runs never reach the upstream resource
+    std::unique_ptr<UpstreamResource> upstreamResource;//resources behind pointers so that the arena stays movable
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> monotonicResource;
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> poolResource;//takes its chunks from 'monotonicResource', declared after it to be destroyed first
+    void makeResources();
+
+  public:
+    explicit RunArena(std::size_t initialSize = 1 << 20);
+    RunArena(const RunArena& other);//a fresh arena with the same buffer size (e.g. one per RunDriver worker)
+    RunArena(RunArena&& other) = default;
+    RunArena& operator = (const RunArena& other) = delete;
+    RunArena& operator = (RunArena&& other) = default;
+    ~RunArena() = default;
+    std::pmr::memory_resource* getResource();//pointer bumps, memory deallocated before the reset is never reused: only for objects living until the reset, e.g. candidate trees
+    std::pmr::memory_resource* getPoolResource();//reuses deallocated blocks, for containers freeing memory during the run, e.g. sliding windows of muon showers
+    template <class T = std::byte>
+    std::pmr::polymorphic_allocator<T> getAllocator();//from 'getResource'
+    template <class T = std::byte>
+    std::pmr::polymorphic_allocator<T> getPoolAllocator();
+    std::size_t getBufferSize() const;
+    std::size_t getOverflowSize() const;//bytes taken from the upstream resource since the last reset
+    void reset();//every object allocated from the arena must have been destroyed (or at least never be used again)
+
+  };
+
+  inline void* RunArena::UpstreamResource::do_allocate(std::size_t bytes, std::size_t alignment){
+    
+    allocatedBytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+
+  }
+
+  inline void RunArena::UpstreamResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment){
+    
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+
+  }
+
+  inline bool RunArena::UpstreamResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept{
+    
+    return this == &other;
+
+  }
+
+  inline std::size_t RunArena::UpstreamResource::getAllocatedBytes() const{
+    
+    return allocatedBytes;
+
+  }
+
+  inline void RunArena::UpstreamResource::resetAllocatedBytes(){
+    
+    allocatedBytes = 0;
+
+  }
+
+  inline void RunArena::makeResources(){
+    
+    monotonicResource = std::make_unique<std::pmr::monotonic_buffer_resource>(buffer.data(), buffer.size(), upstreamResource.get());
+    poolResource = std::make_unique<std::pmr::unsynchronized_pool_resource>(monotonicResource.get());
+
+  }
+
+  inline RunArena::RunArena(std::size_t initialSize):buffer(initialSize),upstreamResource(std::make_unique<UpstreamResource>()){
+    
+    makeResources();
+
+  }
+
+  inline RunArena::RunArena(const RunArena& other):RunArena(other.buffer.size()){
+  
+  }
+
+  inline std::pmr::memory_resource* RunArena::getResource(){
+    
+    return monotonicResource.get();
+
+  }
+
+  inline std::pmr::memory_resource* RunArena::getPoolResource(){
+    
+    return poolResource.get();
+
+  }
+
+  template <class T>
+  std::pmr::polymorphic_allocator<T> RunArena::getAllocator(){
+    
+    return std::pmr::polymorphic_allocator<T>(getResource());
+
+  }
+
+  template <class T>
+  std::pmr::polymorphic_allocator<T> RunArena::getPoolAllocator(){
+    
+    return std::pmr::polymorphic_allocator<T>(getPoolResource());
+
+  }
+
+  inline std::size_t RunArena::getBufferSize() const{
+    
+    return buffer.size();
+
+  }
+
+  inline std::size_t RunArena::getOverflowSize() const{
+    
+    return upstreamResource->getAllocatedBytes();
+
+  }
+
+  inline void RunArena::reset(){
+    
+    poolResource.reset();
+    monotonicResource.reset();//gives the overflow back to the upstream resource
+    if(upstreamResource->getAllocatedBytes() > 0){
+      
+      std::vector<std::byte>(buffer.size() + upstreamResource->getAllocatedBytes()).swap(buffer);
+      upstreamResource->resetAllocatedBytes();
+
+    }
+    makeResources();
+
+  }
+
+}
+
+#endif
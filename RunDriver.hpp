@@ -0,0 +1,83 @@
+#ifndef COSMOGENIC_RUN_DRIVER_H
+#define COSMOGENIC_RUN_DRIVER_H
+
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "Cosmogenic/WorkStealingPool.hpp"
+#include "Cosmogenic/WorkerStatePool.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class WorkerState>
+  class RunDriver{//processes independent runs in parallel, each worker owning a copy of 'WorkerState' (e.g. windows, showers and a VetoSet) which must provide 'void clear()'
+    
+    WorkStealingPool pool;
+    WorkerStatePool<WorkerState> workerStates;//copied once per worker and kept from one call to 'process' to the next, so the copy constructor must deep copy (VetoSet clones its vetoes)
+    
+  public:
+    explicit RunDriver(WorkerState prototype, unsigned numberOfThreads = std::thread::hardware_concurrency());
+    const WorkerState& getPrototype() const;
+    unsigned getNumberOfThreads() const;
+    template <class Run, class RunSize, class ProcessRun>
+    auto process(const std::vector<Run>& runs, RunSize getRunSize, ProcessRun processRun);//returns the outputs of 'processRun(WorkerState&, const Run&)' in run order, the largest runs (according to 'getRunSize') being started first, the state being cleared before each run
+    
+  };
+  
+  template <class WorkerState>
+  RunDriver<WorkerState>::RunDriver(WorkerState prototype, unsigned numberOfThreads)
+  :pool(numberOfThreads),workerStates(std::move(prototype), pool.getNumberOfThreads()){
+    
+  }
+  
+  template <class WorkerState>
+  const WorkerState& RunDriver<WorkerState>::getPrototype() const{
+    
+    return workerStates.getPrototype();
+
+  }
+  
+  template <class WorkerState>
+  unsigned RunDriver<WorkerState>::getNumberOfThreads() const{
+    
+    return pool.getNumberOfThreads();
+
+  }
+  
+  template <class WorkerState>
+  template <class Run, class RunSize, class ProcessRun>
+  auto RunDriver<WorkerState>::process(const std::vector<Run>& runs, RunSize getRunSize, ProcessRun processRun){
+    
+    std::vector<unsigned> runIndices(runs.size());
+    std::iota(runIndices.begin(), runIndices.end(), 0);
+    std::stable_sort(runIndices.begin(), runIndices.end(), [&](unsigned index1, unsigned index2){return getRunSize(runs[index1]) > getRunSize(runs[index2]);});
+    
+    std::vector<decltype(processRun(std::declval<WorkerState&>(), runs.front()))> outputs(runs.size());
+    
+    std::vector<std::function<void(unsigned)>> tasks;
+    tasks.reserve(runs.size());
+    for(auto runIndex : runIndices) tasks.emplace_back([&, runIndex](unsigned workerIndex){
+      
+      auto& workerState = workerStates.get(workerIndex);
+      workerState.clear();//forgets the previous run of that worker, keeping its memory
+      outputs[runIndex] = processRun(workerState, runs[runIndex]);
+      
+    });
+    
+    pool.execute(std::move(tasks));
+    return outputs;
+
+  }
+  
+  template <class Output>
+  Output mergeInOrder(std::vector<Output> outputs){//requires 'Output& Output::operator += (Output&&)'
+    
+    Output mergedOutput;
+    for(auto& output : outputs) mergedOutput += std::move(output);
+    return mergedOutput;
+    
+  }
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef COSMOGENIC_RUN_OUTPUT_H
+#define COSMOGENIC_RUN_OUTPUT_H
+
+#include <vector>
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/CandidateTree.hpp"
+#include "Cosmogenic/CutFlow.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T, class K>
+  struct RunOutput{//what the processing of one (or several merged) run(s) produces
+    
+    std::vector<CandidateTree<T,K>> candidateTrees;
+    CutFlow cutFlow;
+    static constexpr std::uint32_t serializationVersion = 1;
+    template <class Archive>
+    void serialize(Archive& archive, std::uint32_t version);//e.g. to checkpoint the output of a run being processed
+    RunOutput<T,K>& operator += (RunOutput<T,K>&& other);//appends the trees of 'other' after the current ones
+    
+  };
+  
+  template <class T, class K>
+  template <class Archive>
+  void RunOutput<T,K>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(candidateTrees, cutFlow);
+    else throw std::runtime_error(getUnknownVersionMessage<RunOutput<T,K>>("RunOutput", version));
+
+  }
+  
+  template <class T, class K>
+  RunOutput<T,K>& RunOutput<T,K>::operator += (RunOutput<T,K>&& other){
+    
+    candidateTrees.insert(candidateTrees.end(), std::make_move_iterator(other.candidateTrees.begin()), std::make_move_iterator(other.candidateTrees.end()));
+    cutFlow += other.cutFlow;
+    return *this;
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::RunOutput)
+
+#endif
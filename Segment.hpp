@@ -1,6 +1,8 @@
 #ifndef COSMOGENIC_SEGMENT_H
 #define COSMOGENIC_SEGMENT_H
 
+#include <cmath>
+#include <algorithm>
 #include "Cosmogenic/Point.hpp"
 
 namespace CosmogenicHunter{
@@ -147,6 +149,26 @@ namespace CosmogenicHunter{
     
   }
   
+  template <class T>
+  T getDistanceToLine(T dx, T dy, T dz, T directionX, T directionY, T directionZ){//from a point at 'd' of a point of the line, along the unit vector 'direction' (null for a point-like line): one square root instead of the three of Segment::getDistanceTo
+    
+    auto projection = dx * directionX + dy * directionY + dz * directionZ;
+    return std::sqrt(std::max(T(0), dx * dx + dy * dy + dz * dz - projection * projection));
+    
+  }
+  
+  template <class T, class K>
+  T getDistanceToLine(const Point<T>& point, const Segment<K>& segment){//same, to the line of the segment, with the precision of the point whatever the one of the segment
+    
+    const auto& startPoint = segment.getStartPoint();
+    const auto& endPoint = segment.getEndPoint();
+    T lenght = segment.getLenght();
+    T inverseLenght = lenght > 0 ? 1 / lenght : 0;
+    
+    return getDistanceToLine(point.getX() - T(startPoint.getX()), point.getY() - T(startPoint.getY()), point.getZ() - T(startPoint.getZ()), T(endPoint.getX() - startPoint.getX()) * inverseLenght, T(endPoint.getY() - startPoint.getY()) * inverseLenght, T(endPoint.getZ() - startPoint.getZ()) * inverseLenght);
+    
+  }
+  
   template <class T>
   std::ostream& operator<<(std::ostream& output, const Segment<T>& segment){
     
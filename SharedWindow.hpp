@@ -0,0 +1,542 @@
+#ifndef COSMOGENIC_SHARED_WINDOW_H
+#define COSMOGENIC_SHARED_WINDOW_H
+
+#include <array>
+#include <memory>
+#include "boost/iterator/iterator_facade.hpp"
+#include "Cosmogenic/Window.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class SharedWindow{//Window whose copies share their events: copies are O(1), and a modified copy only copies the list of its segments, the segments it writes to and the events it modifies
+    
+    static constexpr std::size_t segmentSize = 32;//events per segment, so that a copy diverging from a window of n events copies n / segmentSize + segmentSize pointers
+    using Segment = std::array<std::shared_ptr<T>, segmentSize>;
+    using Segments = std::pmr::deque<std::shared_ptr<Segment>>;
+    
+    TriggerTime startTime;
+    TriggerTime lenght;
+    std::pmr::memory_resource* memoryResource;//for the events, the segments and the list holding them (polymorphic allocators are not assignable)
+    std::shared_ptr<Segments> segments;//shared between copies until one of them is modified, may start and end with segments holding no event of this window
+    std::size_t firstPosition;//of the first event, counted from the start of the first segment
+    std::size_t numberOfEvents;
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive, std::uint32_t version) const;
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t version);
+    const std::shared_ptr<T>& getEvent(std::size_t position) const;
+    Segments& getUniqueSegments();//copies the list of the segments holding events of this window if it is shared with another window, drops the other segments
+    Segment& getUniqueSegment(std::size_t segmentIndex);//copies the events of this window held by the segment if it is shared, the list of the segments must be unique
+    T& getUniqueEvent(std::size_t position);//copies the event if it is shared with another window, its segment must be unique
+    void appendEvent(std::shared_ptr<T> event);//at the back of the segments, whatever its time
+    void releaseEvents(std::size_t startPosition, std::size_t endPosition);//drops the pointers to erased events from the segments owned by this window only
+    void eraseFront(std::size_t numberOfErased);
+    void eraseBack(std::size_t numberOfErased);
+    void eraseTooYoung(TriggerTime startTime);
+    void eraseTooOld(TriggerTime startTime, TriggerTime lenght);
+    
+  public:
+    class const_iterator : public boost::iterator_facade<const_iterator, const T, std::random_access_iterator_tag>{
+      
+      typename Segments::const_iterator itSegment;
+      std::size_t offset;//of the event in the segment
+      friend class boost::iterator_core_access;
+      const T& dereference() const;
+      bool equal(const const_iterator& other) const;
+      void increment();
+      void decrement();
+      void advance(std::ptrdiff_t numberOfEvents);
+      std::ptrdiff_t distance_to(const const_iterator& other) const;
+      
+    public:
+      const_iterator();
+      const_iterator(typename Segments::const_iterator itSegment, std::size_t offset);
+      
+    };
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(1);
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    SharedWindow();
+    explicit SharedWindow(const allocator_type& allocator);
+    SharedWindow(TriggerTime startTime, TriggerTime lenght, const allocator_type& allocator = {});
+    explicit SharedWindow(const Window<T>& window, const allocator_type& allocator = {});
+    allocator_type get_allocator() const;
+    TriggerTime getStartTime() const;
+    TriggerTime getEndTime() const;
+    TriggerTime getLength() const;
+    unsigned getNumberOfEvents() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const T& front() const;
+    const T& back() const;
+    void setStartTime(TriggerTime startTime);
+    void setLenght(TriggerTime lenght);
+    void setEndTime(TriggerTime endTime);
+    bool covers(TriggerTime triggerTime) const;
+    template <class K>
+    bool covers(const K& event) const;
+    bool isEmpty() const;
+    bool sharesEventsWith(const SharedWindow<T>& other) const;//true until one of the two windows is modified
+    template <class... Args>
+    void emplaceEvent(TriggerTime triggerTime, Args&&... args);
+    void pushBackEvent(const T& event);
+    void pushBackEvent(T&& event);
+    void pushBackEvent(std::shared_ptr<T> event);//e.g. from an ObjectPool, the window copies it before modifying it if it is still shared
+    template <class Predicate, class Modifier>
+    void modifyEventsIf(Predicate predicate, Modifier modifier);//applies 'modifier(T&)' to the events satisfying 'predicate(const T&)', copying them first if they are shared
+    void clear();
+    void print(std::ostream& output, unsigned outputOffset) const;
+    
+  };
+  
+  template <class T>
+  template <class Archive>
+  void SharedWindow<T>::save(Archive& archive, std::uint32_t) const{
+    
+    archive(startTime, lenght, cereal::make_size_tag(static_cast<cereal::size_type>(numberOfEvents)));//same layout as a Window
+    for(const auto& event : *this) archive(event);
+
+  }
+  
+  template <class T>
+  template <class Archive>
+  void SharedWindow<T>::load(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(startTime, lenght);
+    else if(version == getForeignTriggerTimeVersion(1)){
+      
+      loadForeignTriggerTime(archive, startTime);
+      loadForeignTriggerTime(archive, lenght);
+      
+    }
+    else throw std::runtime_error(getUnknownVersionMessage<SharedWindow<T>>("SharedWindow", version));
+    
+    cereal::size_type numberOfLoadedEvents;
+    archive(cereal::make_size_tag(numberOfLoadedEvents));
+    
+    clear();
+    for(cereal::size_type k = 0; k < numberOfLoadedEvents; ++k){
+      
+      auto event = std::allocate_shared<T>(get_allocator());
+      archive(*event);
+      appendEvent(std::move(event));
+      
+    }
+
+  }
+  
+  template <class T>
+  const std::shared_ptr<T>& SharedWindow<T>::getEvent(std::size_t position) const{
+    
+    return (*(*segments)[position / segmentSize])[position % segmentSize];
+
+  }
+  
+  template <class T>
+  typename SharedWindow<T>::Segments& SharedWindow<T>::getUniqueSegments(){
+    
+    auto firstSegment = segments->begin() + firstPosition / segmentSize;
+    auto endSegment = segments->begin() + (firstPosition + numberOfEvents + segmentSize - 1) / segmentSize;
+    if(segments.use_count() > 1) segments = std::allocate_shared<Segments>(get_allocator(), firstSegment, endSegment);
+    else{
+      
+      segments->erase(endSegment, segments->end());
+      segments->erase(segments->begin(), firstSegment);
+      
+    }
+    firstPosition %= segmentSize;
+    return *segments;
+
+  }
+  
+  template <class T>
+  typename SharedWindow<T>::Segment& SharedWindow<T>::getUniqueSegment(std::size_t segmentIndex){
+    
+    auto& segment = (*segments)[segmentIndex];
+    if(segment.use_count() > 1){
+      
+      auto uniqueSegment = std::allocate_shared<Segment>(get_allocator());
+      auto segmentStart = segmentIndex * segmentSize;
+      for(auto position = std::max(firstPosition, segmentStart); position < std::min(firstPosition + numberOfEvents, segmentStart + segmentSize); ++position) (*uniqueSegment)[position - segmentStart] = (*segment)[position - segmentStart];//the events of the other windows are not kept alive
+      segment = std::move(uniqueSegment);
+      
+    }
+    return *segment;
+
+  }
+  
+  template <class T>
+  T& SharedWindow<T>::getUniqueEvent(std::size_t position){
+    
+    auto& event = (*(*segments)[position / segmentSize])[position % segmentSize];
+    if(event.use_count() > 1) event = std::allocate_shared<T>(get_allocator(), *event);
+    return *event;
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::appendEvent(std::shared_ptr<T> event){
+    
+    auto& uniqueSegments = getUniqueSegments();
+    auto position = firstPosition + numberOfEvents;
+    if(position / segmentSize == uniqueSegments.size()) uniqueSegments.push_back(std::allocate_shared<Segment>(get_allocator()));
+    getUniqueSegment(position / segmentSize)[position % segmentSize] = std::move(event);
+    ++numberOfEvents;
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::releaseEvents(std::size_t startPosition, std::size_t endPosition){
+    
+    for(auto position = startPosition; position < endPosition; ++position){
+      
+      auto& segment = (*segments)[position / segmentSize];
+      if(segment.use_count() == 1) (*segment)[position % segmentSize].reset();
+      
+    }
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::eraseFront(std::size_t numberOfErased){
+    
+    if(numberOfErased == 0) return;
+    else if(numberOfErased >= numberOfEvents) clear();
+    else{
+      
+      if(segments.use_count() == 1) releaseEvents(firstPosition, firstPosition + numberOfErased);
+      firstPosition += numberOfErased;
+      numberOfEvents -= numberOfErased;
+      if(segments.use_count() == 1) getUniqueSegments();//drops the segments left, a shared list is left to the next modification
+      
+    }
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::eraseBack(std::size_t numberOfErased){
+    
+    if(numberOfErased == 0) return;
+    else if(numberOfErased >= numberOfEvents) clear();
+    else{
+      
+      if(segments.use_count() == 1) releaseEvents(firstPosition + numberOfEvents - numberOfErased, firstPosition + numberOfEvents);
+      numberOfEvents -= numberOfErased;
+      if(segments.use_count() == 1) getUniqueSegments();
+      
+    }
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::eraseTooYoung(TriggerTime startTime){
+    
+    auto itFirstValid = std::find_if(begin(), end(), [&](const auto& event){return event.getTriggerTime() >= startTime;});
+    eraseFront(std::distance(begin(), itFirstValid));
+    
+  }
+  
+  template <class T>
+  void SharedWindow<T>::eraseTooOld(TriggerTime startTime, TriggerTime lenght){
+    
+    auto itFirstOld = std::find_if(begin(), end(), [&](const auto& event){return event.getTriggerTime() >= startTime + lenght;});
+    eraseBack(std::distance(itFirstOld, end()));
+    
+  }
+  
+  template <class T>
+  const T& SharedWindow<T>::const_iterator::dereference() const{
+    
+    return *(**itSegment)[offset];
+
+  }
+  
+  template <class T>
+  bool SharedWindow<T>::const_iterator::equal(const const_iterator& other) const{
+    
+    return itSegment == other.itSegment && offset == other.offset;
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::const_iterator::increment(){
+    
+    if(++offset == segmentSize){
+      
+      ++itSegment;
+      offset = 0;
+      
+    }
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::const_iterator::decrement(){
+    
+    if(offset == 0){
+      
+      --itSegment;
+      offset = segmentSize;
+      
+    }
+    --offset;
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::const_iterator::advance(std::ptrdiff_t numberOfEvents){
+    
+    auto position = static_cast<std::ptrdiff_t>(offset) + numberOfEvents;
+    auto numberOfSegments = position >= 0 ? position / static_cast<std::ptrdiff_t>(segmentSize) : -((static_cast<std::ptrdiff_t>(segmentSize) - 1 - position) / static_cast<std::ptrdiff_t>(segmentSize));//rounded towards minus infinity
+    itSegment += numberOfSegments;
+    offset = position - numberOfSegments * static_cast<std::ptrdiff_t>(segmentSize);
+
+  }
+  
+  template <class T>
+  std::ptrdiff_t SharedWindow<T>::const_iterator::distance_to(const const_iterator& other) const{
+    
+    return (other.itSegment - itSegment) * static_cast<std::ptrdiff_t>(segmentSize) + static_cast<std::ptrdiff_t>(other.offset) - static_cast<std::ptrdiff_t>(offset);
+
+  }
+  
+  template <class T>
+  SharedWindow<T>::const_iterator::const_iterator():offset(0){
+    
+  }
+  
+  template <class T>
+  SharedWindow<T>::const_iterator::const_iterator(typename Segments::const_iterator itSegment, std::size_t offset):itSegment(itSegment),offset(offset){
+    
+  }
+  
+  template <class T>
+  SharedWindow<T>::SharedWindow():SharedWindow<T>(0, 0){
+    
+  }
+  
+  template <class T>
+  SharedWindow<T>::SharedWindow(const allocator_type& allocator):SharedWindow<T>(0, 0, allocator){
+    
+  }
+  
+  template <class T>
+  SharedWindow<T>::SharedWindow(TriggerTime startTime, TriggerTime lenght, const allocator_type& allocator):startTime(startTime),lenght(std::abs(lenght)),memoryResource(allocator.resource()),segments(std::allocate_shared<Segments>(allocator)),firstPosition(0),numberOfEvents(0){
+    
+  }
+  
+  template <class T>
+  SharedWindow<T>::SharedWindow(const Window<T>& window, const allocator_type& allocator):SharedWindow<T>(window.getStartTime(), window.getLength(), allocator){
+    
+    for(const auto& event : window) appendEvent(std::allocate_shared<T>(get_allocator(), event));
+    
+  }
+
+  template <class T>
+  typename SharedWindow<T>::allocator_type SharedWindow<T>::get_allocator() const{
+    
+    return allocator_type(memoryResource);
+
+  }
+
+  template <class T>
+  TriggerTime SharedWindow<T>::getStartTime() const{
+    
+    return startTime;
+
+  }
+  
+  template <class T>
+  TriggerTime SharedWindow<T>::getEndTime() const{
+    
+    return startTime + lenght;
+
+  }
+
+  template <class T>
+  TriggerTime SharedWindow<T>::getLength() const{
+    
+    return lenght;
+
+  }
+
+  template <class T>
+  unsigned SharedWindow<T>::getNumberOfEvents() const{
+    
+    return numberOfEvents;
+
+  }
+
+  template <class T>
+  typename SharedWindow<T>::const_iterator SharedWindow<T>::begin() const{
+
+    return const_iterator(segments->cbegin() + firstPosition / segmentSize, firstPosition % segmentSize);
+    
+  }
+
+  template <class T>
+  typename SharedWindow<T>::const_iterator SharedWindow<T>::end() const{
+
+    return const_iterator(segments->cbegin() + (firstPosition + numberOfEvents) / segmentSize, (firstPosition + numberOfEvents) % segmentSize);
+    
+  }
+  
+  template <class T>
+  const T& SharedWindow<T>::front() const{
+    
+    return *getEvent(firstPosition);
+
+  }
+  
+  template <class T>
+  const T& SharedWindow<T>::back() const{
+    
+    return *getEvent(firstPosition + numberOfEvents - 1);
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::setStartTime(TriggerTime startTime){
+    
+    if(startTime >= getEndTime()) clear();
+    else if(startTime < getEndTime() && startTime >= this->startTime) eraseTooYoung(startTime);
+    else if(startTime < this->startTime) eraseTooOld(startTime, lenght);
+    
+    this->startTime = startTime;
+
+  }
+
+  template <class T>
+  void SharedWindow<T>::setLenght(TriggerTime lenght){
+    
+    if(lenght > 0){
+    
+      if(lenght < this->lenght) eraseTooOld(startTime, lenght);
+      this->lenght = lenght;
+      
+    }
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::setEndTime(TriggerTime endTime){
+    
+    setStartTime(endTime - lenght);
+
+  }
+
+  template <class T>
+  bool SharedWindow<T>::covers(TriggerTime triggerTime) const{
+
+    return triggerTime >= startTime && triggerTime < startTime + lenght;
+
+  }
+
+  template <class T>
+  template <class K>
+  bool SharedWindow<T>::covers(const K& event) const{
+
+    return covers(event.getTriggerTime());
+
+  }
+
+  template <class T>
+  bool SharedWindow<T>::isEmpty() const{
+    
+    return numberOfEvents == 0;
+
+  }
+  
+  template <class T>
+  bool SharedWindow<T>::sharesEventsWith(const SharedWindow<T>& other) const{
+    
+    return segments == other.segments && firstPosition == other.firstPosition && numberOfEvents == other.numberOfEvents;
+
+  }
+
+  template <class T>
+  template <class... Args>
+  void SharedWindow<T>::emplaceEvent(TriggerTime triggerTime, Args&&... args){
+    
+    if(covers(triggerTime)) appendEvent(std::allocate_shared<T>(get_allocator(), triggerTime, std::forward<Args>(args)...));
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::pushBackEvent(const T& event){
+    
+    if(covers(event)) appendEvent(std::allocate_shared<T>(get_allocator(), event));
+
+  }
+
+  template <class T>
+  void SharedWindow<T>::pushBackEvent(T&& event){
+    
+    if(covers(event)) appendEvent(std::allocate_shared<T>(get_allocator(), std::move(event)));
+
+  }
+
+  template <class T>
+  void SharedWindow<T>::pushBackEvent(std::shared_ptr<T> event){
+    
+    if(covers(*event)) appendEvent(std::move(event));
+
+  }
+  
+  template <class T>
+  template <class Predicate, class Modifier>
+  void SharedWindow<T>::modifyEventsIf(Predicate predicate, Modifier modifier){
+    
+    if(std::none_of(begin(), end(), predicate)) return;//spare the copy of the shared segments
+    
+    getUniqueSegments();
+    for(auto position = firstPosition; position < firstPosition + numberOfEvents; ++position){
+      
+      if(!predicate(static_cast<const T&>(*getEvent(position)))) continue;
+      getUniqueSegment(position / segmentSize);
+      modifier(getUniqueEvent(position));
+      
+    }
+
+  }
+
+  template <class T>
+  void SharedWindow<T>::clear(){
+    
+    if(segments.use_count() > 1) segments = std::allocate_shared<Segments>(get_allocator());
+    else segments->clear();
+    firstPosition = 0;
+    numberOfEvents = 0;
+
+  }
+  
+  template <class T>
+  void SharedWindow<T>::print(std::ostream& output, unsigned outputOffset) const{
+    
+    output<<std::setw(outputOffset)<<std::left<<""<<std::setw(12)<<std::left<<"Start time: "<<std::setw(8)<<std::left<<startTime
+      <<std::setw(8)<<std::left<<" Lenght: "<<std::setw(8)<<std::left<<lenght
+      <<std::setw(14)<<std::left<<"Number of events: "<<std::setw(8)<<std::left<<getNumberOfEvents();
+    
+    for(const auto& event : *this){
+      
+      output<<"\n";
+      event.print(output, outputOffset + 3);
+      
+    }
+    
+  }
+
+  template <class T>
+  std::ostream& operator<<(std::ostream& output, const SharedWindow<T>& sharedWindow){
+    
+    sharedWindow.print(output, 0);
+    return output;
+    
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::SharedWindow)
+
+#endif
@@ -5,95 +5,143 @@
 
 namespace CosmogenicHunter{
 
-  template <class Initiator, class Follower>
+  template <class T>
+  class Muon;
+
+  template <class Initiator, class Follower, class FollowerAggregator = NoAggregator>//e.g. EventStatistics to cut on the total follower energy
   class Shower{
     
     Initiator initiator;//Initiator creating the follower flux
-    Window<Follower> followerWindow;
+    Window<Follower, FollowerAggregator> followerWindow;
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned, see ClassVersion.hpp
+    using allocator_type = typename Window<Follower, FollowerAggregator>::allocator_type;//lets a Window of showers hand its memory resource to their follower windows
     Shower() = default;
-    Shower(Initiator initiator, const CosmogenicHunter::Bounds<double>& timeBounds);//opens a window starting at Initiator.getTriggerTime() and lasting 'timeBounds' to push followers
+    explicit Shower(const allocator_type& allocator);
+    Shower(Initiator initiator, const CosmogenicHunter::Bounds<TriggerTime>& timeBounds, const allocator_type& allocator = {});//opens a window starting at Initiator.getTriggerTime() and lasting 'timeBounds' to push followers
+    Shower(const Shower& other) = default;
+    Shower(const Shower& other, const allocator_type& allocator);
+    Shower(Shower&& other) = default;
+    Shower(Shower&& other, const allocator_type& allocator);
+    Shower& operator = (const Shower& other) = default;
+    Shower& operator = (Shower&& other) = default;
     const Initiator& getInitiator() const;
-    double getTriggerTime() const;//returns Initiator.getTriggerTime() 
-    const Window<Follower>& getFollowerWindow() const;
+    TriggerTime getTriggerTime() const;//returns Initiator.getTriggerTime() 
+    const Window<Follower, FollowerAggregator>& getFollowerWindow() const;
     unsigned getNumberOfFollowers() const;
     template <class... Args>
     void emplaceFollower(Args&&... args);
     void pushBackFollower(const Follower& follower);
     void pushBackFollower(Follower&& follower);
+    void reset(Initiator initiator, const CosmogenicHunter::Bounds<TriggerTime>& timeBounds);//same as constructing a new shower, but reuses the follower window (see ObjectPool)
     void print(std::ostream& output, unsigned outputOffset) const;
     
   };
   
-  template <class Initiator, class Follower>
+  template <class Initiator, class Follower, class FollowerAggregator>
+  template <class Archive>
+  void Shower<Initiator, Follower, FollowerAggregator>::serialize(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(initiator, followerWindow);
+    else throw std::runtime_error(getUnknownVersionMessage<Shower<Initiator, Follower, FollowerAggregator>>("Shower", version));
+
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
   template <class Archive>
-  void Shower<Initiator, Follower>::serialize(Archive& archive){
+  void Shower<Initiator, Follower, FollowerAggregator>::loadUnversioned(Archive& archive){
     
-    archive(initiator, followerWindow);
+    initiator.loadUnversioned(archive);
+    followerWindow.loadUnversioned(archive);
 
   }
   
-  template <class Initiator, class Follower>
-  Shower<Initiator, Follower>::Shower(Initiator initiator, const CosmogenicHunter::Bounds<double>& timeBounds):initiator(std::move(initiator)), followerWindow(initiator.getTriggerTime() + timeBounds.getLowEdge(), timeBounds.getWidth()){
+  template <class Initiator, class Follower, class FollowerAggregator>
+  Shower<Initiator, Follower, FollowerAggregator>::Shower(const allocator_type& allocator):followerWindow(allocator){
+    
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
+  Shower<Initiator, Follower, FollowerAggregator>::Shower(Initiator initiator, const CosmogenicHunter::Bounds<TriggerTime>& timeBounds, const allocator_type& allocator):initiator(std::move(initiator)), followerWindow(initiator.getTriggerTime() + timeBounds.getLowEdge(), timeBounds.getWidth(), allocator){
+    
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
+  Shower<Initiator, Follower, FollowerAggregator>::Shower(const Shower& other, const allocator_type& allocator):initiator(other.initiator),followerWindow(other.followerWindow, allocator){
+    
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
+  Shower<Initiator, Follower, FollowerAggregator>::Shower(Shower&& other, const allocator_type& allocator):initiator(std::move(other.initiator)),followerWindow(std::move(other.followerWindow), allocator){
     
   }
 
-  template <class Initiator, class Follower>
-  const Initiator& Shower<Initiator, Follower>::getInitiator() const{
+  template <class Initiator, class Follower, class FollowerAggregator>
+  const Initiator& Shower<Initiator, Follower, FollowerAggregator>::getInitiator() const{
     
     return initiator;
 
   }
   
-  template <class Initiator, class Follower>
-  double Shower<Initiator, Follower>::getTriggerTime() const{
+  template <class Initiator, class Follower, class FollowerAggregator>
+  TriggerTime Shower<Initiator, Follower, FollowerAggregator>::getTriggerTime() const{
 
     return initiator.getTriggerTime();
     
   }
 
-  template <class Initiator, class Follower>
-  const Window<Follower>& Shower<Initiator, Follower>::getFollowerWindow() const{
+  template <class Initiator, class Follower, class FollowerAggregator>
+  const Window<Follower, FollowerAggregator>& Shower<Initiator, Follower, FollowerAggregator>::getFollowerWindow() const{
     
     return followerWindow;
 
   }
   
-  template <class Initiator, class Follower>
-  unsigned Shower<Initiator, Follower>::getNumberOfFollowers() const{
+  template <class Initiator, class Follower, class FollowerAggregator>
+  unsigned Shower<Initiator, Follower, FollowerAggregator>::getNumberOfFollowers() const{
     
     return followerWindow.getNumberOfEvents();
 
   }
   
-  template <class Initiator, class Follower>
+  template <class Initiator, class Follower, class FollowerAggregator>
   template <class... Args>
-  void Shower<Initiator, Follower>::emplaceFollower(Args&&... args){
+  void Shower<Initiator, Follower, FollowerAggregator>::emplaceFollower(Args&&... args){
 
     followerWindow.emplaceEvent(std::forward<Args>(args)...);
 
   }
   
-  template <class Initiator, class Follower>
-  void Shower<Initiator, Follower>::pushBackFollower(const Follower& follower){
+  template <class Initiator, class Follower, class FollowerAggregator>
+  void Shower<Initiator, Follower, FollowerAggregator>::pushBackFollower(const Follower& follower){
 
     followerWindow.pushBackEvent(follower);
     
   }
   
-  template <class Initiator, class Follower>
-  void Shower<Initiator, Follower>::pushBackFollower(Follower&& follower){
+  template <class Initiator, class Follower, class FollowerAggregator>
+  void Shower<Initiator, Follower, FollowerAggregator>::pushBackFollower(Follower&& follower){
 
     followerWindow.pushBackEvent(std::move(follower));//keep the r-value character with std::move
     
   }
   
-  template <class Initiator, class Follower>
-  void Shower<Initiator, Follower>::print(std::ostream& output, unsigned outputOffset) const{
+  template <class Initiator, class Follower, class FollowerAggregator>
+  void Shower<Initiator, Follower, FollowerAggregator>::reset(Initiator initiator, const CosmogenicHunter::Bounds<TriggerTime>& timeBounds){
+    
+    this->initiator = std::move(initiator);
+    followerWindow.reset(this->initiator.getTriggerTime() + timeBounds.getLowEdge(), timeBounds.getWidth());
+    
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
+  void Shower<Initiator, Follower, FollowerAggregator>::print(std::ostream& output, unsigned outputOffset) const{
 
     output<<std::setw(outputOffset)<<std::left<<""<<std::setw(9)<<std::left<<"Initiator"<<":\n";
     initiator.print(output, outputOffset + 3);//offset the initiator by 3 spaces
@@ -107,8 +155,22 @@ namespace CosmogenicHunter{
     
   }
   
-  template <class Initiator, class Follower>
-  std::ostream& operator<<(std::ostream& output, const Shower<Initiator,Follower>& shower){
+  template <class K>
+  const Muon<K>& getMuon(const Muon<K>& muon){//so that the same code reads Muon's and muon Shower's
+    
+    return muon;
+    
+  }
+  
+  template <class K, class Follower, class FollowerAggregator>
+  const Muon<K>& getMuon(const Shower<Muon<K>, Follower, FollowerAggregator>& muonShower){
+    
+    return muonShower.getInitiator();
+    
+  }
+  
+  template <class Initiator, class Follower, class FollowerAggregator>
+  std::ostream& operator<<(std::ostream& output, const Shower<Initiator, Follower, FollowerAggregator>& shower){
     
     shower.print(output, 0);
     return output;
@@ -117,6 +179,6 @@ namespace CosmogenicHunter{
 
 }
 
-
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Shower)
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define COSMOGENIC_SINGLE_H
 
 #include "Cosmogenic/Event.hpp"
+#include "Cosmogenic/Precision.hpp"
 #include "Cosmogenic/PositionInformation.hpp"
 #include "Cosmogenic/InnerVetoInformation.hpp"
 #include "Cosmogenic/ChargeInformation.hpp"
@@ -26,29 +27,37 @@ namespace CosmogenicHunter{
   template <class T>
   class ChimneyVeto;
   
-  template <class T>
+  template <class T, class Payload>//see Precision.hpp, 'Payload' defaults to T
   class Single : public Event<T>{
     
     PositionInformation<T> positionInformation;//RecoBAMA reconstructed positon and functional value
     InnerVetoInformation<T> innerVetoInformation;//chargeIV, number of hit IV PMTs
-    ChargeInformation<T> chargeInformation;//QRMS, QDiff, QRatio, startTimeRMS
-    T chimneyInconsistencyRatio;///ratio: minus log (pulse shape likelihood in the chimney) / minus log (pulse shape likelihood at reconstruction positon)
-    T cosmogenicLikelihood;
+    ChargeInformation<Payload> chargeInformation;//QRMS, QDiff, QRatio, startTimeRMS
+    Payload chimneyInconsistencyRatio;///ratio: minus log (pulse shape likelihood in the chimney) / minus log (pulse shape likelihood at reconstruction positon)
+    Payload cosmogenicLikelihood;
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
+    void serialize(Archive& archive, std::uint32_t version);
     
   public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned (always with 'Payload' T), see ClassVersion.hpp
     Single();
-    Single(double triggerTime, T visibleEnergy, unsigned identifier, PositionInformation<T> positionInformation, InnerVetoInformation<T> innerVetoInformation, ChargeInformation<T> chargeInformation, T chimneyInconsistencyRatio, T cosmogenicLikelihood);
+    Single(TriggerTime triggerTime, T visibleEnergy, unsigned identifier, PositionInformation<T> positionInformation, InnerVetoInformation<T> innerVetoInformation, ChargeInformation<Payload> chargeInformation, T chimneyInconsistencyRatio, T cosmogenicLikelihood);
+    template <class K>
+    Single(const Single<T, K>& other);//conversion between precisions, e.g. to hand a mixed precision single to the vetoes which read Single<T>'s
     const PositionInformation<T>& getPositionInformation() const;
     const InnerVetoInformation<T>& getInnerVetoInformation() const;
-    const ChargeInformation<T>& getChargeInformation() const;
+    const ChargeInformation<Payload>& getChargeInformation() const;
     T getChimneyInconsistencyRatio() const;
     T getCosmogenicLikelihood() const;
+    void setCosmogenicLikelihood(T cosmogenicLikelihood);//e.g. from a CosmogenicLikelihood
     T getDistanceTo(const Muon<T>& muon) const;//shortest distance to Muon's track
-    T getSpaceCorrelation(const Single<T>& other) const;
-    bool isSpaceCorrelated(const Single<T>& other, T maxDistance) const;
+    template <class K>
+    T getSpaceCorrelation(const Single<T, K>& other) const;
+    template <class K>
+    bool isSpaceCorrelated(const Single<T, K>& other, T maxDistance) const;
     bool isLightNoise(const LightNoiseVeto<T>& lightNoiseVeto) const;
     bool isVetoed(const InnerVeto<T>& innerVetoThreshold) const;
     bool isPoorlyReconstructed(const ReconstructionVeto<T>& reconstructionVeto) const;
@@ -58,118 +67,155 @@ namespace CosmogenicHunter{
     
   };
   
-  template <class T>
+  template <class T, class Payload>
   template <class Archive>
-  void Single<T>::serialize(Archive& archive){
+  void Single<T, Payload>::serialize(Archive& archive, std::uint32_t version){
     
-    archive(cereal::base_class<Event<T>>(this), positionInformation, innerVetoInformation, chargeInformation, chimneyInconsistencyRatio, cosmogenicLikelihood);
+    if(version == serializationVersion) archive(cereal::base_class<Event<T>>(this), positionInformation, innerVetoInformation, chargeInformation, chimneyInconsistencyRatio, cosmogenicLikelihood);
+    else throw std::runtime_error(getUnknownVersionMessage<Single<T, Payload>>("Single", version));
 
   }
   
-  template <class T>
-  Single<T>::Single():chimneyInconsistencyRatio(std::numeric_limits<T>::max()){
+  template <class T, class Payload>
+  template <class Archive>
+  void Single<T, Payload>::loadUnversioned(Archive& archive){
+    
+    if constexpr(std::is_same<T, Payload>::value){
+      
+      Event<T>::loadUnversioned(archive);
+      archive(positionInformation, innerVetoInformation, chargeInformation, chimneyInconsistencyRatio, cosmogenicLikelihood);
+      
+    }
+    else{
+      
+      Single<T> single;
+      single.loadUnversioned(archive);
+      *this = Single<T, Payload>(single);
+      
+    }
+
+  }
+  
+  template <class T, class Payload>
+  Single<T, Payload>::Single():chimneyInconsistencyRatio(std::numeric_limits<Payload>::max()){
     
   }
 
-  template <class T>
-  Single<T>::Single(double triggerTime, T visibleEnergy, unsigned identifier, PositionInformation<T> positionInformation, InnerVetoInformation<T> innerVetoInformation, ChargeInformation<T> chargeInformation, T chimneyInconsistencyRatio, T cosmogenicLikelihood)
-  :Event<T>(triggerTime, visibleEnergy, identifier),positionInformation(std::move(positionInformation)),innerVetoInformation(std::move(innerVetoInformation)),chargeInformation(std::move(chargeInformation)),chimneyInconsistencyRatio(chimneyInconsistencyRatio),cosmogenicLikelihood(cosmogenicLikelihood){
+  template <class T, class Payload>
+  Single<T, Payload>::Single(TriggerTime triggerTime, T visibleEnergy, unsigned identifier, PositionInformation<T> positionInformation, InnerVetoInformation<T> innerVetoInformation, ChargeInformation<Payload> chargeInformation, T chimneyInconsistencyRatio, T cosmogenicLikelihood)
+  :Event<T>(triggerTime, visibleEnergy, identifier),positionInformation(std::move(positionInformation)),innerVetoInformation(std::move(innerVetoInformation)),chargeInformation(std::move(chargeInformation)),chimneyInconsistencyRatio(static_cast<Payload>(chimneyInconsistencyRatio)),cosmogenicLikelihood(static_cast<Payload>(cosmogenicLikelihood)){
     
   }
   
-  template <class T>
-  const PositionInformation<T>& Single<T>::getPositionInformation() const{
+  template <class T, class Payload>
+  template <class K>
+  Single<T, Payload>::Single(const Single<T, K>& other)
+  :Event<T>(other),positionInformation(other.getPositionInformation()),innerVetoInformation(other.getInnerVetoInformation()),chargeInformation(other.getChargeInformation()),chimneyInconsistencyRatio(static_cast<Payload>(other.getChimneyInconsistencyRatio())),cosmogenicLikelihood(static_cast<Payload>(other.getCosmogenicLikelihood())){
+    
+  }
+  
+  template <class T, class Payload>
+  const PositionInformation<T>& Single<T, Payload>::getPositionInformation() const{
     
     return positionInformation;
 
   }
 
-  template <class T>
-  const InnerVetoInformation<T>& Single<T>::getInnerVetoInformation() const{
+  template <class T, class Payload>
+  const InnerVetoInformation<T>& Single<T, Payload>::getInnerVetoInformation() const{
     
     return innerVetoInformation;
 
   }
   
-  template <class T>
-  const ChargeInformation<T>& Single<T>::getChargeInformation() const{
+  template <class T, class Payload>
+  const ChargeInformation<Payload>& Single<T, Payload>::getChargeInformation() const{
     
     return chargeInformation;
     
   }
   
-  template <class T>
-  T Single<T>::getChimneyInconsistencyRatio() const{
+  template <class T, class Payload>
+  T Single<T, Payload>::getChimneyInconsistencyRatio() const{
     
-    return chimneyInconsistencyRatio;
+    return static_cast<T>(chimneyInconsistencyRatio);
     
   }
   
-  template <class T>
-  T Single<T>::getCosmogenicLikelihood() const{
+  template <class T, class Payload>
+  T Single<T, Payload>::getCosmogenicLikelihood() const{
     
-    return cosmogenicLikelihood;
+    return static_cast<T>(cosmogenicLikelihood);
     
   }
   
-  template <class T>
-  T Single<T>::getDistanceTo(const Muon<T>& muon) const{
+  template <class T, class Payload>
+  void Single<T, Payload>::setCosmogenicLikelihood(T cosmogenicLikelihood){
+    
+    this->cosmogenicLikelihood = static_cast<Payload>(cosmogenicLikelihood);
+    
+  }
+  
+  template <class T, class Payload>
+  T Single<T, Payload>::getDistanceTo(const Muon<T>& muon) const{
 
     return getDistanceBetween(positionInformation.getPosition(), muon.getTrack());
   
   }
 
-  template <class T>
-  T Single<T>::getSpaceCorrelation(const Single<T>& other) const{
+  template <class T, class Payload>
+  template <class K>
+  T Single<T, Payload>::getSpaceCorrelation(const Single<T, K>& other) const{
 
     return getDistanceBetween(positionInformation.getPosition(), other.getPositionInformation().getPosition());
   
   }
 
-  template <class T>
-  bool Single<T>::isSpaceCorrelated(const Single<T>& other, T maxDistance) const{
+  template <class T, class Payload>
+  template <class K>
+  bool Single<T, Payload>::isSpaceCorrelated(const Single<T, K>& other, T maxDistance) const{
 
     return getSpaceCorrelation(other) < maxDistance;
   
   }
   
-  template <class T>
-  bool Single<T>::isLightNoise(const LightNoiseVeto<T>& lightNoiseVeto) const{
+  template <class T, class Payload>
+  bool Single<T, Payload>::isLightNoise(const LightNoiseVeto<T>& lightNoiseVeto) const{
     
     return lightNoiseVeto.veto(*this);
     
   }
   
-  template <class T>
-  bool Single<T>::isVetoed(const InnerVeto<T>& innerVetoThreshold) const{
+  template <class T, class Payload>
+  bool Single<T, Payload>::isVetoed(const InnerVeto<T>& innerVetoThreshold) const{
     
     return innerVetoThreshold.veto(*this);
     
   }
   
-  template <class T>
-  bool Single<T>::isPoorlyReconstructed(const ReconstructionVeto<T>& reconstructionVeto) const{
+  template <class T, class Payload>
+  bool Single<T, Payload>::isPoorlyReconstructed(const ReconstructionVeto<T>& reconstructionVeto) const{
 
     return reconstructionVeto.veto(*this);
   
   }
   
-  template <class T>
-  bool Single<T>::isBufferMuon(const BufferMuonVeto<T>& bufferMuonVeto) const{
+  template <class T, class Payload>
+  bool Single<T, Payload>::isBufferMuon(const BufferMuonVeto<T>& bufferMuonVeto) const{
 
     return bufferMuonVeto.veto(*this);
   
   }
   
-  template <class T>
-  bool Single<T>::isCosmogenic(T cosmogenicLikelihoodThreshold) const{
+  template <class T, class Payload>
+  bool Single<T, Payload>::isCosmogenic(T cosmogenicLikelihoodThreshold) const{
 
-    return cosmogenicLikelihood > cosmogenicLikelihoodThreshold;
+    return static_cast<T>(cosmogenicLikelihood) > cosmogenicLikelihoodThreshold;
   
   }
   
-  template <class T>
-  void Single<T>::print(std::ostream& output, unsigned outputOffset) const{
+  template <class T, class Payload>
+  void Single<T, Payload>::print(std::ostream& output, unsigned outputOffset) const{
     
     unsigned firstColumnWidth = 13;
     Event<T>::print(output, outputOffset);//print the base class
@@ -186,38 +232,38 @@ namespace CosmogenicHunter{
 
   }
   
-  template <class T>
-  std::ostream& operator<<(std::ostream& output, const Single<T>& single){
+  template <class T, class Payload>
+  std::ostream& operator<<(std::ostream& output, const Single<T, Payload>& single){
     
     single.print(output, 0);
     return output;
     
   }
   
-  template <class T>
-  T getDistanceBetween(const Single<T>& single, const Muon<T>& muon){
+  template <class T, class Payload>
+  T getDistanceBetween(const Single<T, Payload>& single, const Muon<T>& muon){
     
     return single.getDistanceTo(muon);
     
   }
   
-  template <class T>
-  T getDistanceBetween(const Muon<T>& muon, const Single<T>& single){
+  template <class T, class Payload>
+  T getDistanceBetween(const Muon<T>& muon, const Single<T, Payload>& single){
     
     return getDistanceBetween(single, muon);
     
   }
 
 
-  template <class T>
-  double getSpaceCorrelation(const Single<T>& single1, const Single<T>& single2){
+  template <class T, class Payload1, class Payload2>
+  double getSpaceCorrelation(const Single<T, Payload1>& single1, const Single<T, Payload2>& single2){
 
     return single1.getSpaceCorrelation(single2);
   
   }
 
-  template <class T>
-  bool areSpaceCorrelated(const Single<T>& single1, const Single<T>& single2, T maxDistance){
+  template <class T, class Payload1, class Payload2>
+  bool areSpaceCorrelated(const Single<T, Payload1>& single1, const Single<T, Payload2>& single2, T maxDistance){
 
     return single1.isSpaceCorrelated(single2, maxDistance);
   
@@ -225,5 +271,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Single)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+#ifndef COSMOGENIC_TABULATED_FUNCTION_H
+#define COSMOGENIC_TABULATED_FUNCTION_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class TabulatedFunction{//values at evenly spaced nodes linearly interpolated, e.g. a PDF of the distance to the muon track
+    
+    T lowEdge;
+    T upEdge;
+    T inverseNodeSpacing;
+    std::vector<T> values;//at lowEdge, lowEdge + spacing, ..., upEdge
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive, std::uint32_t version) const;
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t version);
+    void check() const;
+
+  public:
+    static constexpr std::uint32_t serializationVersion = 1;
+    TabulatedFunction();
+    TabulatedFunction(T lowEdge, T upEdge, std::vector<T> values);//at least two values, the first at 'lowEdge' and the last at 'upEdge'
+    template <class Function>
+    TabulatedFunction(T lowEdge, T upEdge, unsigned numberOfNodes, Function function);//samples 'function' at the nodes
+    T getLowEdge() const;
+    T getUpEdge() const;
+    unsigned getNumberOfNodes() const;
+    T getNodeSpacing() const;
+    T getNode(unsigned nodeIndex) const;
+    const std::vector<T>& getValues() const;
+    T getMinValue() const;
+    T getMaxValue() const;
+    T getIntegral() const;//exact for the interpolated function
+    void normalize();//scales the values to a unit integral, e.g. for a PDF
+    T getValue(T x) const;//values outside the edges are the ones at the closest edge, branchless and inline so that loops over many x vectorise
+    T operator()(T x) const;
+
+  };
+
+  template <class T>
+  template <class Archive>
+  void TabulatedFunction<T>::save(Archive& archive, std::uint32_t) const{
+    
+    archive(lowEdge, upEdge, values);
+
+  }
+
+  template <class T>
+  template <class Archive>
+  void TabulatedFunction<T>::load(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(lowEdge, upEdge, values);
+    else throw std::runtime_error(getUnknownVersionMessage<TabulatedFunction<T>>("TabulatedFunction", version));
+
+    check();
+    inverseNodeSpacing = (values.size() - 1) / (upEdge - lowEdge);
+
+  }
+
+  template <class T>
+  void TabulatedFunction<T>::check() const{
+    
+    if(!(lowEdge < upEdge)) throw std::invalid_argument(std::to_string(lowEdge)+" and "+std::to_string(upEdge)+" are not valid edges for a tabulated function.");
+    if(values.size() < 2) throw std::invalid_argument(std::to_string(values.size())+" is not a valid number of nodes for a tabulated function.");
+
+  }
+
+  template <class T>
+  TabulatedFunction<T>::TabulatedFunction():TabulatedFunction(0, 1, std::vector<T>(2, 0)){
+  
+  }
+
+  template <class T>
+  TabulatedFunction<T>::TabulatedFunction(T lowEdge, T upEdge, std::vector<T> values):lowEdge(lowEdge),upEdge(upEdge),values(std::move(values)){
+    
+    check();
+    inverseNodeSpacing = (this->values.size() - 1) / (upEdge - lowEdge);
+
+  }
+
+  template <class T>
+  template <class Function>
+  TabulatedFunction<T>::TabulatedFunction(T lowEdge, T upEdge, unsigned numberOfNodes, Function function):TabulatedFunction(lowEdge, upEdge, std::vector<T>(std::max(numberOfNodes, 2u))){
+    
+    if(numberOfNodes < 2) throw std::invalid_argument(std::to_string(numberOfNodes)+" is not a valid number of nodes for a tabulated function.");
+    for(unsigned k = 0; k < numberOfNodes; ++k) values[k] = function(getNode(k));
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getLowEdge() const{
+    
+    return lowEdge;
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getUpEdge() const{
+    
+    return upEdge;
+
+  }
+
+  template <class T>
+  unsigned TabulatedFunction<T>::getNumberOfNodes() const{
+    
+    return values.size();
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getNodeSpacing() const{
+    
+    return (upEdge - lowEdge) / (values.size() - 1);
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getNode(unsigned nodeIndex) const{
+    
+    if(nodeIndex + 1 == values.size()) return upEdge;//no rounding on the last node
+    else return lowEdge + nodeIndex * getNodeSpacing();
+
+  }
+
+  template <class T>
+  const std::vector<T>& TabulatedFunction<T>::getValues() const{
+    
+    return values;
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getMinValue() const{
+    
+    return *std::min_element(values.begin(), values.end());
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getMaxValue() const{
+    
+    return *std::max_element(values.begin(), values.end());
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::getIntegral() const{
+    
+    T integral = 0;
+    for(unsigned k = 0; k + 1 < values.size(); ++k) integral += values[k] + values[k + 1];
+    return integral * getNodeSpacing() / 2;//trapezoids
+
+  }
+
+  template <class T>
+  void TabulatedFunction<T>::normalize(){
+    
+    auto integral = getIntegral();
+    if(!(integral > 0)) throw std::invalid_argument(std::to_string(integral)+" is not a valid integral to normalize a tabulated function.");
+    for(auto& value : values) value /= integral;
+
+  }
+
+  template <class T>
+  inline T TabulatedFunction<T>::getValue(T x) const{
+    
+    T lastInterval = values.size() - 2;
+    auto position = std::min(lastInterval + 1, std::max(T(0), (x - lowEdge) * inverseNodeSpacing));//in units of the node spacing, NaN's go to the low edge
+    auto nodeIndex = static_cast<int>(std::min(position, lastInterval));
+    auto fraction = position - nodeIndex;
+    return values[nodeIndex] + fraction * (values[nodeIndex + 1] - values[nodeIndex]);
+
+  }
+
+  template <class T>
+  T TabulatedFunction<T>::operator()(T x) const{
+    
+    return getValue(x);
+
+  }
+
+}
+
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::TabulatedFunction)
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef COSMOGENIC_TIME_SLICER_H
+#define COSMOGENIC_TIME_SLICER_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "Cosmogenic/Bounds.hpp"
+#include "Cosmogenic/TriggerTime.hpp"
+#include "Cosmogenic/WorkStealingPool.hpp"
+#include "Cosmogenic/WorkerStatePool.hpp"
+
+namespace CosmogenicHunter{
+
+  class TimeSlice{//owns the outputs keyed in 'ownedBounds' and needs the events in 'loadedBounds' (owned bounds plus halos) to compute them
+    
+    Bounds<TriggerTime> ownedBounds;
+    Bounds<TriggerTime> loadedBounds;
+    
+  public:
+    TimeSlice() = default;
+    TimeSlice(Bounds<TriggerTime> ownedBounds, TriggerTime lookBack, TriggerTime lookAhead);
+    const Bounds<TriggerTime>& getOwnedBounds() const;
+    const Bounds<TriggerTime>& getLoadedBounds() const;
+    bool owns(TriggerTime triggerTime) const;
+    template <class Event>
+    bool owns(const Event& event) const;
+    template <class Event>
+    std::pair<typename std::vector<Event>::const_iterator, typename std::vector<Event>::const_iterator> getLoadedRange(const std::vector<Event>& events) const;//'events' must be time ordered
+    
+  };
+  
+  class TimeSlicer{//splits one run in time slices processed in parallel
+    
+    TriggerTime lookBack;//largest time before the key of an output that the output depends on
+    TriggerTime lookAhead;//largest time after it
+    WorkStealingPool pool;
+    
+  public:
+    TimeSlicer(TriggerTime lookBack, TriggerTime lookAhead, unsigned numberOfThreads = std::thread::hardware_concurrency());
+    TimeSlicer(TriggerTime muonWindowLength, const Bounds<TriggerTime>& followerTimeBounds, const Bounds<TriggerTime>& pairTimeBounds, unsigned numberOfThreads = std::thread::hardware_concurrency());//halos for CandidateTree's keyed by their prompt
+    TriggerTime getLookBack() const;
+    TriggerTime getLookAhead() const;
+    std::vector<TimeSlice> getSlices(TriggerTime startTime, TriggerTime endTime, unsigned numberOfSlices) const;//slices of equal durations
+    template <class Event>
+    std::vector<TimeSlice> getSlices(const std::vector<Event>& events, unsigned numberOfSlices) const;//slices with equal numbers of (time ordered) events
+    template <class ProcessSlice>
+    auto process(const std::vector<TimeSlice>& slices, ProcessSlice processSlice) const;//returns the outputs of 'processSlice(const TimeSlice&)' in slice order
+    template <class WorkerState, class ProcessSlice>
+    auto process(const std::vector<TimeSlice>& slices, WorkerStatePool<WorkerState>& workerStates, ProcessSlice processSlice) const;//same with 'processSlice(WorkerState&, const TimeSlice&)', the pool needing one state per thread, cleared with 'WorkerState::clear()' before each slice as in RunDriver
+    
+  };
+  
+  inline TimeSlice::TimeSlice(Bounds<TriggerTime> ownedBounds, TriggerTime lookBack, TriggerTime lookAhead)
+  :ownedBounds(ownedBounds),loadedBounds(ownedBounds.getLowEdge() - lookBack, ownedBounds.getUpEdge() + lookAhead){
+    
+  }
+  
+  inline const Bounds<TriggerTime>& TimeSlice::getOwnedBounds() const{
+    
+    return ownedBounds;
+
+  }
+  
+  inline const Bounds<TriggerTime>& TimeSlice::getLoadedBounds() const{
+    
+    return loadedBounds;
+
+  }
+  
+  inline bool TimeSlice::owns(TriggerTime triggerTime) const{
+    
+    return ownedBounds.contains(triggerTime);
+
+  }
+  
+  template <class Event>
+  bool TimeSlice::owns(const Event& event) const{
+    
+    return owns(event.getTriggerTime());
+
+  }
+  
+  template <class Event>
+  std::pair<typename std::vector<Event>::const_iterator, typename std::vector<Event>::const_iterator> TimeSlice::getLoadedRange(const std::vector<Event>& events) const{
+    
+    auto itFirst = std::lower_bound(events.begin(), events.end(), loadedBounds.getLowEdge(), [](const auto& event, TriggerTime time){return event.getTriggerTime() < time;});
+    auto itLast = std::lower_bound(itFirst, events.end(), loadedBounds.getUpEdge(), [](const auto& event, TriggerTime time){return event.getTriggerTime() < time;});
+    return std::make_pair(itFirst, itLast);
+
+  }
+  
+  inline TimeSlicer::TimeSlicer(TriggerTime lookBack, TriggerTime lookAhead, unsigned numberOfThreads)
+  :lookBack(lookBack),lookAhead(lookAhead),pool(numberOfThreads){
+    
+    if(lookBack < 0 || lookAhead < 0){
+      
+      auto errorMessage = std::to_string(lookBack)+"ns and "+std::to_string(lookAhead)+"ns are invalid time slice halos.";
+      throw std::invalid_argument(errorMessage);
+      
+    }
+    
+  }
+  
+  inline TimeSlicer::TimeSlicer(TriggerTime muonWindowLength, const Bounds<TriggerTime>& followerTimeBounds, const Bounds<TriggerTime>& pairTimeBounds, unsigned numberOfThreads)
+  :TimeSlicer(muonWindowLength - std::min(followerTimeBounds.getLowEdge(), TriggerTime(0)), std::max({followerTimeBounds.getUpEdge(), pairTimeBounds.getUpEdge(), TriggerTime(0)}), numberOfThreads){//the followers of the oldest muon may precede it, those of the youngest one may come after the prompt
+    
+  }
+  
+  inline TriggerTime TimeSlicer::getLookBack() const{
+    
+    return lookBack;
+
+  }
+  
+  inline TriggerTime TimeSlicer::getLookAhead() const{
+    
+    return lookAhead;
+
+  }
+  
+  inline std::vector<TimeSlice> TimeSlicer::getSlices(TriggerTime startTime, TriggerTime endTime, unsigned numberOfSlices) const{
+    
+    if(endTime < startTime || numberOfSlices == 0) throw std::invalid_argument("Cannot slice ["+std::to_string(startTime)+", "+std::to_string(endTime)+"[ in "+std::to_string(numberOfSlices)+" slices.");
+    
+    std::vector<TimeSlice> slices;
+    auto sliceDuration = (endTime - startTime) / numberOfSlices;
+    for(unsigned k = 0; k < numberOfSlices; ++k){
+      
+      auto lowEdge = startTime + k * sliceDuration;
+      auto upEdge = (k + 1 == numberOfSlices) ? endTime : startTime + (k + 1) * sliceDuration;//the last slice ends exactly at 'endTime' despite rounding
+      slices.emplace_back(Bounds<TriggerTime>(lowEdge, upEdge), lookBack, lookAhead);
+      
+    }
+    
+    return slices;
+
+  }
+  
+  template <class Event>
+  std::vector<TimeSlice> TimeSlicer::getSlices(const std::vector<Event>& events, unsigned numberOfSlices) const{
+    
+    if(numberOfSlices == 0) throw std::invalid_argument("Cannot split events in zero slices.");
+    
+    std::vector<TimeSlice> slices;
+    if(events.empty()) return slices;
+    
+    auto endTime = getNextTriggerTime(events.back().getTriggerTime());//the slices cover the last event
+    auto lowEdge = events.front().getTriggerTime();
+    for(unsigned k = 1; k <= numberOfSlices && lowEdge < endTime; ++k){
+      
+      auto upEdge = (k == numberOfSlices) ? endTime : std::max(lowEdge, events[k * events.size() / numberOfSlices].getTriggerTime());
+      if(upEdge > lowEdge){
+        
+        slices.emplace_back(Bounds<TriggerTime>(lowEdge, upEdge), lookBack, lookAhead);
+        lowEdge = upEdge;
+        
+      }
+      
+    }
+    
+    return slices;
+
+  }
+  
+  template <class ProcessSlice>
+  auto TimeSlicer::process(const std::vector<TimeSlice>& slices, ProcessSlice processSlice) const{
+    
+    std::vector<decltype(processSlice(std::declval<const TimeSlice&>()))> outputs(slices.size());
+    
+    std::vector<std::function<void(unsigned)>> tasks;
+    tasks.reserve(slices.size());
+    for(unsigned sliceIndex = 0; sliceIndex < slices.size(); ++sliceIndex) tasks.emplace_back([&, sliceIndex](unsigned){
+      
+      outputs[sliceIndex] = processSlice(slices[sliceIndex]);
+      
+    });
+    
+    pool.execute(std::move(tasks));
+    return outputs;
+
+  }
+  
+  template <class WorkerState, class ProcessSlice>
+  auto TimeSlicer::process(const std::vector<TimeSlice>& slices, WorkerStatePool<WorkerState>& workerStates, ProcessSlice processSlice) const{
+    
+    if(workerStates.getNumberOfWorkers() < pool.getNumberOfThreads()) throw std::invalid_argument(std::to_string(workerStates.getNumberOfWorkers())+" worker states cannot serve "+std::to_string(pool.getNumberOfThreads())+" threads.");
+    
+    std::vector<decltype(processSlice(std::declval<WorkerState&>(), std::declval<const TimeSlice&>()))> outputs(slices.size());
+    
+    std::vector<std::function<void(unsigned)>> tasks;
+    tasks.reserve(slices.size());
+    for(unsigned sliceIndex = 0; sliceIndex < slices.size(); ++sliceIndex) tasks.emplace_back([&, sliceIndex](unsigned workerIndex){
+      
+      auto& workerState = workerStates.get(workerIndex);
+      workerState.clear();//forgets the previous slice of that worker, so that outputs do not depend on the scheduling
+      outputs[sliceIndex] = processSlice(workerState, slices[sliceIndex]);
+      
+    });
+    
+    pool.execute(std::move(tasks));
+    return outputs;
+
+  }
+
+}
+
+#endif
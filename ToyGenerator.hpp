@@ -0,0 +1,532 @@
+#ifndef COSMOGENIC_TOY_GENERATOR_H
+#define COSMOGENIC_TOY_GENERATOR_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include "Cosmogenic/Muon.hpp"
+#include "Cosmogenic/Single.hpp"
+#include "Cosmogenic/WorkStealingPool.hpp"
+
+namespace CosmogenicHunter{
+
+  struct ToyIsotope{//cosmogenic isotope produced along the muon tracks, e.g. 9Li
+    
+    double lifetime;//ns
+    double yieldPerMuon;//mean number per muon
+    double yieldPerShoweringMuon;//mean number per showering muon
+    double neutronBranchingRatio;//fraction of the decays followed by a neutron capture
+    double minEnergy;//MeV, the beta spectrum is taken flat
+    double maxEnergy;
+
+  };
+
+  struct ToyParameters{//defaults close to a far detector, lenghts in mm, times in ns, energies in MeV, rates per ns
+    
+    double detectorRadius = 1708;//cylinder where the singles are reconstructed and the muons deposit their visible energy
+    double detectorHalfHeight = 1786;
+    double vetoRadius = 3300;//cylinder crossed by all the muons
+    double vetoHalfHeight = 3400;
+    double muonRate = 46e-9;
+    double muonEnergyLoss = 0.2;//MeV per mm within the detector
+    double vetoChargeLoss = 10;//DUQ per mm within the veto only
+    double energyToIDChargeFactor = 3e4;//DUQ per MeV
+    double showeringProbability = 0.05;//of the muons crossing the detector
+    double meanShowerEnergy = 800;//exponentially distributed, on top of the track energy
+    double neutronsPerMuon = 0.05;//mean number of neutron captures
+    double neutronsPerShoweringMuon = 5;
+    double neutronCaptureTime = 30e3;
+    double neutronEnergy = 8;
+    double neutronEnergyResolution = 0.08;//relative
+    double neutronLateralDistance = 300;//mean distance between the track and the capture
+    double neutronTravelDistance = 150;//mean distance between an isotope decay and its neutron capture
+    double isotopeLateralDistance = 500;//mean distance between the track and the decay
+    std::vector<ToyIsotope> isotopes{{257.2e6, 1e-5, 2e-3, 0.508, 0, 13.6}, {171.7e6, 2e-6, 4e-4, 0.16, 0, 10.6}};//9Li and 8He
+    double accidentalRate = 10e-9;
+    double minAccidentalEnergy = 0.5;
+    double meanAccidentalEnergy = 1.5;//exponentially distributed above the min
+    double lightNoiseRate = 5e-9;//singles failing the light noise cuts
+    double meanLightNoiseEnergy = 2;
+    double ibdRate = 0;//inverse beta decays uncorrelated to the muons (e.g. reactor antineutrinos): a positron then a neutron capture
+    double minIBDEnergy = 1;//MeV, the positron spectrum is taken flat
+    double maxIBDEnergy = 8;
+
+  };
+
+  enum ToyOrigin : std::uint8_t {accidental, lightNoise, neutron, isotopeDecay, isotopeNeutron, ibdPositron, ibdNeutron};
+
+  template <class T>
+  struct ToySingleColumns{//one vector per member, e.g. for the columnar CosmogenicLikelihood::fill
+    
+    std::vector<TriggerTime> triggerTimes;
+    std::vector<T> visibleEnergies;
+    std::vector<T> xs;
+    std::vector<T> ys;
+    std::vector<T> zs;
+    std::vector<unsigned> identifiers;
+
+  };
+
+  template <class K>
+  struct ToyMuonColumns{//e.g. for the columnar MuonDefinition::tag
+    
+    std::vector<TriggerTime> triggerTimes;
+    std::vector<K> visibleEnergies;
+    std::vector<K> vetoCharges;
+    std::vector<K> detectorCharges;
+    std::vector<std::array<K, 6>> tracks;//start then end point
+    std::vector<unsigned> identifiers;
+
+  };
+
+  template <class T, class K>
+  struct ToyRun{//time-ordered streams, identifiers number the muons and singles together in time order
+    
+    std::vector<Muon<K>> muons;
+    std::vector<Single<T>> singles;
+    std::vector<ToyOrigin> singleOrigins;
+    std::vector<unsigned> parentIdentifiers;//of the muon producing each single, max unsigned for the accidentals and light noise
+    ToyMuonColumns<K> getMuonColumns(std::size_t begin, std::size_t end) const;
+    ToySingleColumns<T> getSingleColumns(std::size_t begin, std::size_t end) const;
+
+  };
+
+  template <class T, class K>
+  class ToyGenerator{//seeded toy Monte Carlo of the muon and single streams of a run, for benchmarks and stress tests: the run is cut in slices generated in parallel, each from its own seed, so that the output only depends on the seed
+    
+    using Position = std::array<double, 3>;
+    static constexpr double twoPi = 6.283185307179586;
+
+    struct GeneratedMuon{
+      
+      double triggerTime;
+      double visibleEnergy;
+      double vetoCharge;
+      Position startPoint;
+      Position endPoint;
+
+    };
+
+    struct GeneratedSingle{
+      
+      double triggerTime;
+      double visibleEnergy;
+      Position position;
+      double positionInconsistency;
+      double chargeRMS;
+      double chargeDifference;
+      double chargeRatio;
+      double startTimeRMS;
+      double chimneyInconsistencyRatio;
+      ToyOrigin origin;
+      unsigned parentIndex;//of the muon within the slice
+
+    };
+
+    struct Slice{
+      
+      std::vector<GeneratedMuon> muons;
+      std::vector<GeneratedSingle> singles;
+
+    };
+
+    ToyParameters parameters;
+    TriggerTime sliceDuration;
+    WorkStealingPool pool;
+    static bool getChord(const Position& point, const Position& direction, double radius, double halfHeight, double& entry, double& exit);//of the line through 'point' along the unit 'direction'
+    bool isInDetector(const Position& position) const;
+    void addSingle(double triggerTime, double visibleEnergy, const Position& position, ToyOrigin origin, unsigned parentIndex, std::mt19937_64& generator, Slice& slice) const;//dropped if not in the detector
+    void addFollowers(const Position& point, const Position& direction, double entry, double exit, bool isShowering, std::mt19937_64& generator, Slice& slice) const;
+    Position getCapturePosition(const Position& origin, std::mt19937_64& generator) const;//of a neutron travelling isotropically from 'origin'
+    Slice generateSlice(double startTime, double endTime, double runEndTime, std::uint64_t seed, unsigned sliceIndex) const;
+
+  public:
+    ToyGenerator(ToyParameters parameters = ToyParameters(), TriggerTime sliceDuration = 1e9, unsigned numberOfThreads = std::thread::hardware_concurrency());//followers of the muons of a slice may land in the next ones, the slices only set the parallelism
+    const ToyParameters& getParameters() const;
+    TriggerTime getSliceDuration() const;
+    unsigned getNumberOfThreads() const;
+    ToyRun<T,K> generate(TriggerTime duration, std::uint64_t seed, TriggerTime startTime = 0) const;//followers beyond the end of the run are dropped
+
+  };
+
+  template <class T, class K>
+  ToyMuonColumns<K> ToyRun<T,K>::getMuonColumns(std::size_t begin, std::size_t end) const{
+    
+    end = std::min(end, muons.size());
+    ToyMuonColumns<K> columns;
+    for(auto it = muons.begin() + std::min(begin, end); it != muons.begin() + end; ++it){
+      
+      const auto& startPoint = it->getTrack().getStartPoint();
+      const auto& endPoint = it->getTrack().getEndPoint();
+      columns.triggerTimes.push_back(it->getTriggerTime());
+      columns.visibleEnergies.push_back(it->template Event<K>::getVisibleEnergy());
+      columns.vetoCharges.push_back(it->getVetoCharge());
+      columns.detectorCharges.push_back(it->getDetectorCharge());
+      columns.tracks.push_back({startPoint.getX(), startPoint.getY(), startPoint.getZ(), endPoint.getX(), endPoint.getY(), endPoint.getZ()});
+      columns.identifiers.push_back(it->getIdentifier());
+
+    }
+
+    return columns;
+
+  }
+
+  template <class T, class K>
+  ToySingleColumns<T> ToyRun<T,K>::getSingleColumns(std::size_t begin, std::size_t end) const{
+    
+    end = std::min(end, singles.size());
+    ToySingleColumns<T> columns;
+    for(auto it = singles.begin() + std::min(begin, end); it != singles.begin() + end; ++it){
+      
+      const auto& position = it->getPositionInformation().getPosition();
+      columns.triggerTimes.push_back(it->getTriggerTime());
+      columns.visibleEnergies.push_back(it->getVisibleEnergy());
+      columns.xs.push_back(position.getX());
+      columns.ys.push_back(position.getY());
+      columns.zs.push_back(position.getZ());
+      columns.identifiers.push_back(it->getIdentifier());
+
+    }
+
+    return columns;
+
+  }
+
+  template <class T, class K>
+  bool ToyGenerator<T,K>::getChord(const Position& point, const Position& direction, double radius, double halfHeight, double& entry, double& exit){
+    
+    entry = std::numeric_limits<double>::lowest();
+    exit = std::numeric_limits<double>::max();
+
+    auto a = direction[0] * direction[0] + direction[1] * direction[1];
+    auto b = 2 * (point[0] * direction[0] + point[1] * direction[1]);
+    auto c = point[0] * point[0] + point[1] * point[1] - radius * radius;
+    if(a > 0){
+      
+      auto discriminant = b * b - 4 * a * c;
+      if(discriminant <= 0) return false;
+      entry = (-b - std::sqrt(discriminant)) / (2 * a);
+      exit = (-b + std::sqrt(discriminant)) / (2 * a);
+
+    }
+    else if(c > 0) return false;//vertical outside of the cylinder
+
+    if(direction[2] != 0){
+      
+      auto top = (halfHeight - point[2]) / direction[2], bottom = (-halfHeight - point[2]) / direction[2];
+      entry = std::max(entry, std::min(top, bottom));
+      exit = std::min(exit, std::max(top, bottom));
+
+    }
+    else if(std::abs(point[2]) > halfHeight) return false;
+
+    return entry < exit;
+
+  }
+
+  template <class T, class K>
+  bool ToyGenerator<T,K>::isInDetector(const Position& position) const{
+    
+    return position[0] * position[0] + position[1] * position[1] < parameters.detectorRadius * parameters.detectorRadius && std::abs(position[2]) < parameters.detectorHalfHeight;
+
+  }
+
+  template <class T, class K>
+  void ToyGenerator<T,K>::addSingle(double triggerTime, double visibleEnergy, const Position& position, ToyOrigin origin, unsigned parentIndex, std::mt19937_64& generator, Slice& slice) const{
+    
+    if(!isInDetector(position)) return;
+
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::exponential_distribution<double> exponential(1);
+    if(origin == ToyOrigin::lightNoise) slice.singles.push_back(GeneratedSingle{triggerTime, visibleEnergy, position, 3 * exponential(generator), 500 + 500 * uniform(generator), 3e4 + 3e4 * uniform(generator), 0.15 + 0.7 * uniform(generator), 40 + 40 * uniform(generator), 1 + 2 * exponential(generator), origin, parentIndex});
+    else slice.singles.push_back(GeneratedSingle{triggerTime, visibleEnergy, position, exponential(generator), 200 + 200 * uniform(generator), 2e3 * uniform(generator), 0.02 + 0.06 * uniform(generator), 15 + 10 * uniform(generator), 1 + 2 * exponential(generator), origin, parentIndex});//passes the light noise and buffer muon cuts
+
+  }
+
+  template <class T, class K>
+  void ToyGenerator<T,K>::addFollowers(const Position& point, const Position& direction, double entry, double exit, bool isShowering, std::mt19937_64& generator, Slice& slice) const{
+    
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::exponential_distribution<double> exponential(1);
+    unsigned parentIndex = slice.muons.size() - 1;
+    auto muonTime = slice.muons.back().triggerTime;
+
+    Position firstAxis = std::abs(direction[2]) < 0.9 ? Position{-direction[1], direction[0], 0} : Position{0, -direction[2], direction[1]};//orthonormal basis of the plane perpendicular to the track
+    auto norm = std::sqrt(firstAxis[0] * firstAxis[0] + firstAxis[1] * firstAxis[1] + firstAxis[2] * firstAxis[2]);
+    for(auto& coordinate : firstAxis) coordinate /= norm;
+    Position secondAxis{direction[1] * firstAxis[2] - direction[2] * firstAxis[1], direction[2] * firstAxis[0] - direction[0] * firstAxis[2], direction[0] * firstAxis[1] - direction[1] * firstAxis[0]};
+    auto getPositionNearTrack = [&](double meanDistance){
+      
+      auto lenght = entry + (exit - entry) * uniform(generator);
+      auto distance = meanDistance * exponential(generator);
+      auto angle = twoPi * uniform(generator);
+      Position position;
+      for(unsigned k = 0; k < 3; ++k) position[k] = point[k] + lenght * direction[k] + distance * (std::cos(angle) * firstAxis[k] + std::sin(angle) * secondAxis[k]);
+      return position;
+
+    };
+    auto getNeutronEnergy = [&](){
+      
+      std::normal_distribution<double> energyDistribution(parameters.neutronEnergy, parameters.neutronEnergyResolution * parameters.neutronEnergy);
+      return std::max(energyDistribution(generator), 0.);
+
+    };
+
+    auto meanNumberOfNeutrons = isShowering ? parameters.neutronsPerShoweringMuon : parameters.neutronsPerMuon;
+    unsigned numberOfNeutrons = meanNumberOfNeutrons > 0 ? std::poisson_distribution<unsigned>(meanNumberOfNeutrons)(generator) : 0;
+    for(unsigned k = 0; k < numberOfNeutrons; ++k){
+      
+      auto captureTime = muonTime + parameters.neutronCaptureTime * exponential(generator);
+      auto energy = getNeutronEnergy();
+      addSingle(captureTime, energy, getPositionNearTrack(parameters.neutronLateralDistance), ToyOrigin::neutron, parentIndex, generator, slice);
+
+    }
+
+    for(const auto& isotope : parameters.isotopes){
+      
+      auto meanNumberOfDecays = isShowering ? isotope.yieldPerShoweringMuon : isotope.yieldPerMuon;
+      unsigned numberOfDecays = meanNumberOfDecays > 0 ? std::poisson_distribution<unsigned>(meanNumberOfDecays)(generator) : 0;
+      for(unsigned k = 0; k < numberOfDecays; ++k){
+        
+        auto decayTime = muonTime + isotope.lifetime * exponential(generator);
+        auto decayPosition = getPositionNearTrack(parameters.isotopeLateralDistance);
+        addSingle(decayTime, isotope.minEnergy + (isotope.maxEnergy - isotope.minEnergy) * uniform(generator), decayPosition, ToyOrigin::isotopeDecay, parentIndex, generator, slice);
+        if(uniform(generator) < isotope.neutronBranchingRatio){
+          
+          auto captureTime = decayTime + parameters.neutronCaptureTime * exponential(generator);
+          auto capturePosition = getCapturePosition(decayPosition, generator);
+          auto energy = getNeutronEnergy();
+          addSingle(captureTime, energy, capturePosition, ToyOrigin::isotopeNeutron, parentIndex, generator, slice);
+
+        }
+
+      }
+
+    }
+
+  }
+
+  template <class T, class K>
+  typename ToyGenerator<T,K>::Position ToyGenerator<T,K>::getCapturePosition(const Position& origin, std::mt19937_64& generator) const{
+    
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::exponential_distribution<double> exponential(1);
+    auto distance = parameters.neutronTravelDistance * exponential(generator);
+    auto cosTheta = 2 * uniform(generator) - 1, phi = twoPi * uniform(generator);//isotropic
+    auto sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+    return Position{origin[0] + distance * sinTheta * std::cos(phi), origin[1] + distance * sinTheta * std::sin(phi), origin[2] + distance * cosTheta};
+
+  }
+
+  template <class T, class K>
+  typename ToyGenerator<T,K>::Slice ToyGenerator<T,K>::generateSlice(double startTime, double endTime, double runEndTime, std::uint64_t seed, unsigned sliceIndex) const{
+    
+    std::seed_seq seedSequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), sliceIndex};
+    std::mt19937_64 generator(seedSequence);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::exponential_distribution<double> exponential(1);
+    Slice slice;
+
+    if(parameters.muonRate > 0){
+      
+      auto diskRadius = parameters.vetoRadius + 2 * parameters.vetoHalfHeight;//covers all the tracks within 45 degrees from the vertical
+      for(auto muonTime = startTime + exponential(generator) / parameters.muonRate; muonTime < endTime; muonTime += exponential(generator) / parameters.muonRate){
+        
+        Position point, direction;
+        double vetoEntry, vetoExit;
+        do{//uniform on a disk above the veto, cos^2 zenith angle flux through it
+          
+          auto radius = diskRadius * std::sqrt(uniform(generator)), angle = twoPi * uniform(generator);
+          point = Position{radius * std::cos(angle), radius * std::sin(angle), parameters.vetoHalfHeight};
+          auto cosTheta = std::pow(uniform(generator), 0.25), phi = twoPi * uniform(generator);
+          auto sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+          direction = Position{sinTheta * std::cos(phi), sinTheta * std::sin(phi), -cosTheta};
+
+        }
+        while(!getChord(point, direction, parameters.vetoRadius, parameters.vetoHalfHeight, vetoEntry, vetoExit));
+
+        double detectorEntry, detectorExit;
+        bool crossesDetector = getChord(point, direction, parameters.detectorRadius, parameters.detectorHalfHeight, detectorEntry, detectorExit);
+        auto detectorLenght = crossesDetector ? detectorExit - detectorEntry : 0;
+        bool isShowering = crossesDetector && uniform(generator) < parameters.showeringProbability;
+        auto visibleEnergy = parameters.muonEnergyLoss * detectorLenght + (isShowering ? parameters.meanShowerEnergy * exponential(generator) : 0);
+
+        Position startPoint, endPoint;
+        for(unsigned k = 0; k < 3; ++k){
+          
+          startPoint[k] = point[k] + vetoEntry * direction[k];
+          endPoint[k] = point[k] + vetoExit * direction[k];
+
+        }
+        slice.muons.push_back(GeneratedMuon{muonTime, visibleEnergy, parameters.vetoChargeLoss * (vetoExit - vetoEntry - detectorLenght), startPoint, endPoint});
+        addFollowers(point, direction, vetoEntry, vetoExit, isShowering, generator, slice);
+
+      }
+
+    }
+
+    auto getPositionInDetector = [&](){
+      
+      auto radius = parameters.detectorRadius * std::sqrt(uniform(generator)), angle = twoPi * uniform(generator);
+      return Position{radius * std::cos(angle), radius * std::sin(angle), parameters.detectorHalfHeight * (2 * uniform(generator) - 1)};
+
+    };
+    auto addUncorrelatedSingles = [&](double rate, ToyOrigin origin, double minEnergy, double meanEnergy){
+      
+      if(rate <= 0) return;
+      for(auto time = startTime + exponential(generator) / rate; time < endTime; time += exponential(generator) / rate){
+        
+        auto position = getPositionInDetector();
+        addSingle(time, minEnergy + meanEnergy * exponential(generator), position, origin, std::numeric_limits<unsigned>::max(), generator, slice);
+
+      }
+
+    };
+    addUncorrelatedSingles(parameters.accidentalRate, ToyOrigin::accidental, parameters.minAccidentalEnergy, parameters.meanAccidentalEnergy);
+    addUncorrelatedSingles(parameters.lightNoiseRate, ToyOrigin::lightNoise, 0, parameters.meanLightNoiseEnergy);
+    
+    if(parameters.ibdRate > 0){//drawn last so that the other events do not depend on it
+      
+      std::normal_distribution<double> neutronEnergyDistribution(parameters.neutronEnergy, parameters.neutronEnergyResolution * parameters.neutronEnergy);
+      for(auto time = startTime + exponential(generator) / parameters.ibdRate; time < endTime; time += exponential(generator) / parameters.ibdRate){
+        
+        auto position = getPositionInDetector();
+        addSingle(time, parameters.minIBDEnergy + (parameters.maxIBDEnergy - parameters.minIBDEnergy) * uniform(generator), position, ToyOrigin::ibdPositron, std::numeric_limits<unsigned>::max(), generator, slice);
+        auto captureTime = time + parameters.neutronCaptureTime * exponential(generator);
+        auto capturePosition = getCapturePosition(position, generator);
+        addSingle(captureTime, std::max(neutronEnergyDistribution(generator), 0.), capturePosition, ToyOrigin::ibdNeutron, std::numeric_limits<unsigned>::max(), generator, slice);
+
+      }
+
+    }
+
+    slice.singles.erase(std::remove_if(slice.singles.begin(), slice.singles.end(), [&](const auto& single){return single.triggerTime >= runEndTime;}), slice.singles.end());
+    std::stable_sort(slice.singles.begin(), slice.singles.end(), [](const auto& single1, const auto& single2){return single1.triggerTime < single2.triggerTime;});
+    return slice;
+
+  }
+
+  template <class T, class K>
+  ToyGenerator<T,K>::ToyGenerator(ToyParameters parameters, TriggerTime sliceDuration, unsigned numberOfThreads)
+  :parameters(std::move(parameters)),sliceDuration(sliceDuration),pool(numberOfThreads){
+    
+    const auto& p = this->parameters;
+    if(!(p.detectorRadius > 0 && p.detectorHalfHeight > 0 && p.vetoRadius >= p.detectorRadius && p.vetoHalfHeight >= p.detectorHalfHeight)) throw std::invalid_argument("The toy detector must be a non empty cylinder within the veto one.");
+    if(p.muonRate < 0 || p.accidentalRate < 0 || p.lightNoiseRate < 0 || p.ibdRate < 0) throw std::invalid_argument("The toy event rates cannot be negative.");
+    if(p.minIBDEnergy > p.maxIBDEnergy) throw std::invalid_argument(std::to_string(p.minIBDEnergy)+"MeV is not a valid minimum IBD energy.");
+    if(p.showeringProbability < 0 || p.showeringProbability > 1) throw std::invalid_argument(std::to_string(p.showeringProbability)+" is not a valid showering probability.");
+    for(const auto& isotope : p.isotopes){
+      
+      if(!(isotope.lifetime > 0) || isotope.yieldPerMuon < 0 || isotope.yieldPerShoweringMuon < 0 || isotope.neutronBranchingRatio < 0 || isotope.neutronBranchingRatio > 1 || isotope.minEnergy > isotope.maxEnergy) throw std::invalid_argument(std::to_string(isotope.lifetime)+"ns is not a valid lifetime or comes with invalid yields, branching ratio or energies.");
+
+    }
+    if(!(sliceDuration > 0)) throw std::invalid_argument(std::to_string(sliceDuration)+"ns is not a valid slice duration.");
+
+  }
+
+  template <class T, class K>
+  const ToyParameters& ToyGenerator<T,K>::getParameters() const{
+    
+    return parameters;
+
+  }
+
+  template <class T, class K>
+  TriggerTime ToyGenerator<T,K>::getSliceDuration() const{
+    
+    return sliceDuration;
+
+  }
+
+  template <class T, class K>
+  unsigned ToyGenerator<T,K>::getNumberOfThreads() const{
+    
+    return pool.getNumberOfThreads();
+
+  }
+
+  template <class T, class K>
+  ToyRun<T,K> ToyGenerator<T,K>::generate(TriggerTime duration, std::uint64_t seed, TriggerTime startTime) const{
+    
+    if(duration < 0) throw std::invalid_argument(std::to_string(duration)+"ns is not a valid run duration.");
+
+    unsigned numberOfSlices = std::ceil(static_cast<double>(duration) / sliceDuration);
+    double runEndTime = static_cast<double>(startTime) + duration;
+    std::vector<Slice> slices(numberOfSlices);
+    std::vector<std::function<void(unsigned)>> tasks;
+    for(unsigned k = 0; k < numberOfSlices; ++k){
+      
+      tasks.emplace_back([&, k](unsigned){
+        
+        double sliceStartTime = static_cast<double>(startTime) + static_cast<double>(k) * sliceDuration;
+        slices[k] = generateSlice(sliceStartTime, std::min(sliceStartTime + sliceDuration, runEndTime), runEndTime, seed, k);
+
+      });
+
+    }
+    pool.execute(std::move(tasks));
+
+    std::vector<unsigned> muonOffsets(numberOfSlices + 1, 0);//of the slices in the run muons
+    for(unsigned k = 0; k < numberOfSlices; ++k) muonOffsets[k + 1] = muonOffsets[k] + slices[k].muons.size();
+
+    std::vector<GeneratedSingle> singles;//the muons of the slices are already in time order, but not their followers
+    for(auto& slice : slices){
+      
+      for(auto& single : slice.singles) if(single.parentIndex != std::numeric_limits<unsigned>::max()) single.parentIndex += muonOffsets[&slice - slices.data()];
+      singles.insert(singles.end(), slice.singles.begin(), slice.singles.end());
+      slice.singles = std::vector<GeneratedSingle>();
+
+    }
+    std::stable_sort(singles.begin(), singles.end(), [](const auto& single1, const auto& single2){return single1.triggerTime < single2.triggerTime;});
+
+    ToyRun<T,K> run;
+    run.muons.reserve(muonOffsets.back());
+    run.singles.reserve(singles.size());
+    run.singleOrigins.reserve(singles.size());
+    run.parentIdentifiers.reserve(singles.size());
+    std::vector<unsigned> muonIdentifiers;
+    muonIdentifiers.reserve(muonOffsets.back());
+
+    unsigned identifier = 0;
+    auto itSingle = singles.begin();
+    auto addSingles = [&](double endTime){//up to 'endTime' excluded
+      
+      for(; itSingle != singles.end() && itSingle->triggerTime < endTime; ++itSingle){
+        
+        const auto& single = *itSingle;
+        PositionInformation<T> positionInformation(Point<T>(single.position[0], single.position[1], single.position[2]), single.positionInconsistency);
+        InnerVetoInformation<T> innerVetoInformation(0, 0, 0, parameters.vetoRadius - parameters.detectorRadius);
+        ChargeInformation<T> chargeInformation(single.chargeRMS, single.chargeDifference, single.chargeRatio, single.startTimeRMS);
+        run.singles.emplace_back(static_cast<TriggerTime>(single.triggerTime), single.visibleEnergy, identifier++, positionInformation, innerVetoInformation, chargeInformation, single.chimneyInconsistencyRatio, 0);
+        run.singleOrigins.push_back(single.origin);
+        run.parentIdentifiers.push_back(single.parentIndex != std::numeric_limits<unsigned>::max() ? muonIdentifiers.at(single.parentIndex) : std::numeric_limits<unsigned>::max());//followers come after their muon
+
+      }
+
+    };
+    for(const auto& slice : slices){
+      
+      for(const auto& muon : slice.muons){
+        
+        addSingles(muon.triggerTime);
+        Segment<K> track(Point<K>(muon.startPoint[0], muon.startPoint[1], muon.startPoint[2]), Point<K>(muon.endPoint[0], muon.endPoint[1], muon.endPoint[2]));
+        muonIdentifiers.push_back(identifier);
+        run.muons.emplace_back(static_cast<TriggerTime>(muon.triggerTime), muon.visibleEnergy, identifier++, std::move(track), muon.vetoCharge, muon.visibleEnergy * parameters.energyToIDChargeFactor);
+
+      }
+
+    }
+    addSingles(std::numeric_limits<double>::infinity());
+
+    return run;
+
+  }
+
+}
+
+#endif
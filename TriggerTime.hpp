@@ -0,0 +1,111 @@
+#ifndef COSMOGENIC_TRIGGER_TIME_H
+#define COSMOGENIC_TRIGGER_TIME_H
+
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+//define COSMOGENIC_INTEGER_TRIGGER_TIME before including any header of the library to store trigger times as integer ticks of 1 ns counted from the start of the run
+//time comparisons are then exact at any absolute time (a double only resolves 16 ns around 1e17 ns) and coincidence searches use integer arithmetics
+namespace CosmogenicHunter{
+
+#ifdef COSMOGENIC_INTEGER_TRIGGER_TIME
+  using TriggerTime = std::int64_t;//ns since the run epoch, also used for time differences
+  using ForeignTriggerTime = double;//representation of archives written without the flag
+#else
+  using TriggerTime = double;//ns
+  using ForeignTriggerTime = std::int64_t;//representation of archives written with the flag
+#endif
+
+  constexpr bool hasIntegerTriggerTime = std::is_integral<TriggerTime>::value;
+  constexpr std::uint32_t getTriggerTimeVersion(std::uint32_t version){//serialization version of a class storing trigger times: odd with double, even with ticks
+
+    return hasIntegerTriggerTime ? version + 1 : version;
+
+  }
+
+  constexpr std::uint32_t getForeignTriggerTimeVersion(std::uint32_t version){//same layout written with the other representation
+
+    return hasIntegerTriggerTime ? version : version + 1;
+
+  }
+
+  inline TriggerTime toTriggerTime(ForeignTriggerTime time){
+    
+    if(hasIntegerTriggerTime) return std::llround(time);
+    else return time;
+
+  }
+
+  template <class Archive>
+  void loadForeignTriggerTime(Archive& archive, TriggerTime& triggerTime){//reads a time serialized with the other representation
+
+    ForeignTriggerTime foreignTriggerTime;
+    archive(foreignTriggerTime);
+    triggerTime = toTriggerTime(foreignTriggerTime);
+
+  }
+
+  template <class Archive>
+  void loadUnversionedTriggerTime(Archive& archive, TriggerTime& triggerTime){//reads a time serialized before the archives were versioned, always a double
+
+    double unversionedTriggerTime;
+    archive(unversionedTriggerTime);
+    if(hasIntegerTriggerTime) triggerTime = std::llround(unversionedTriggerTime);
+    else triggerTime = unversionedTriggerTime;
+
+  }
+
+  inline TriggerTime getNextTriggerTime(TriggerTime triggerTime){//smallest representable trigger time after 'triggerTime'
+
+    if(hasIntegerTriggerTime) return triggerTime + 1;
+    else return std::nextafter(triggerTime, std::numeric_limits<TriggerTime>::max());
+
+  }
+
+  class RunEpoch{//origin of the trigger times of a run, given in absolute ns of the DAQ clock
+
+    std::int64_t startTime;
+
+  public:
+    explicit RunEpoch(std::int64_t startTime = 0);
+    std::int64_t getStartTime() const;
+    TriggerTime getTriggerTime(std::int64_t absoluteTime) const;//subtraction done on integers so that no precision is lost before the conversion
+    std::int64_t getAbsoluteTime(TriggerTime triggerTime) const;
+    TriggerTime getOffsetTo(const RunEpoch& other) const;//to shift the trigger times of this run onto the axis of 'other', see 'Event::shiftTriggerTime'
+
+  };
+
+  inline RunEpoch::RunEpoch(std::int64_t startTime):startTime(startTime){
+  
+  }
+
+  inline std::int64_t RunEpoch::getStartTime() const{
+    
+    return startTime;
+
+  }
+
+  inline TriggerTime RunEpoch::getTriggerTime(std::int64_t absoluteTime) const{
+    
+    return absoluteTime - startTime;
+
+  }
+
+  inline std::int64_t RunEpoch::getAbsoluteTime(TriggerTime triggerTime) const{
+    
+    return startTime + std::llround(triggerTime);
+
+  }
+
+  inline TriggerTime RunEpoch::getOffsetTo(const RunEpoch& other) const{
+    
+    return startTime - other.startTime;
+
+  }
+
+}
+
+#endif
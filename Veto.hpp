@@ -3,12 +3,10 @@
 
 #include <memory>
 #include <iostream>
+#include "Cosmogenic/Precision.hpp"
 
 namespace CosmogenicHunter{
   
-  template <class T>
-  class Single;
-  
   template <class T>
   class CandidatePair;
   
@@ -29,6 +27,7 @@ namespace CosmogenicHunter{
     virtual bool veto(const Single<T>& single) const = 0;//tag or reject the single
     virtual bool veto(const CandidatePair<T>& candidatePair) const = 0;//tag or reject the pair (may call veto(single) on prompt and/or delayed)
     virtual std::unique_ptr<Veto<T>> clone() const = 0;
+    virtual void clear();//forgets the state kept from the previous events (e.g. between runs), nothing for stateless vetoes
     virtual void print(std::ostream& output) const = 0;//needed to act as if 'operator<<' was virtual
     
   };
@@ -45,6 +44,11 @@ namespace CosmogenicHunter{
     
   }
   
+  template <class T>
+  void Veto<T>::clear(){
+    
+  }
+  
   template <class T>
   void Veto<T>::print(std::ostream& output) const{
     
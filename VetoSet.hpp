@@ -0,0 +1,146 @@
+#ifndef COSMOGENIC_VETO_SET_H
+#define COSMOGENIC_VETO_SET_H
+
+#include <vector>
+#include <algorithm>
+#include "Cosmogenic/Veto.hpp"
+#include "Cosmogenic/CutFlow.hpp"
+
+namespace CosmogenicHunter{
+
+  template <class T>
+  class VetoSet{//ordered list of vetoes, copies clone every veto so that each thread can own its set
+    
+    std::vector<std::unique_ptr<Veto<T>>> vetoes;
+    
+  public:
+    VetoSet() = default;
+    VetoSet(const VetoSet<T>& other);
+    VetoSet(VetoSet<T>&& other) = default;
+    VetoSet<T>& operator = (const VetoSet<T>& other);
+    VetoSet<T>& operator = (VetoSet<T>&& other) = default;
+    ~VetoSet() = default;
+    unsigned getNumberOfVetoes() const;
+    typename std::vector<std::unique_ptr<Veto<T>>>::const_iterator begin() const;
+    typename std::vector<std::unique_ptr<Veto<T>>>::const_iterator end() const;
+    void addVeto(const Veto<T>& veto);
+    void addVeto(std::unique_ptr<Veto<T>> veto);
+    void clear();//clears every veto (e.g. between runs), keeps the vetoes
+    template <class Vetoable>
+    bool veto(const Vetoable& vetoable) const;//true if any veto applies
+    template <class Vetoable>
+    bool veto(const Vetoable& vetoable, CutFlow& cutFlow) const;//same, but counts the inputs and the rejections by the first veto that applies
+    void print(std::ostream& output) const;
+    
+  };
+  
+  template <class T>
+  VetoSet<T>::VetoSet(const VetoSet<T>& other){
+    
+    vetoes.reserve(other.vetoes.size());
+    for(const auto& veto : other.vetoes) vetoes.push_back(veto->clone());
+    
+  }
+  
+  template <class T>
+  VetoSet<T>& VetoSet<T>::operator = (const VetoSet<T>& other){
+    
+    if(this != &other) *this = VetoSet<T>(other);
+    return *this;
+    
+  }
+  
+  template <class T>
+  unsigned VetoSet<T>::getNumberOfVetoes() const{
+    
+    return vetoes.size();
+
+  }
+  
+  template <class T>
+  typename std::vector<std::unique_ptr<Veto<T>>>::const_iterator VetoSet<T>::begin() const{
+
+    return vetoes.begin();
+    
+  }
+
+  template <class T>
+  typename std::vector<std::unique_ptr<Veto<T>>>::const_iterator VetoSet<T>::end() const{
+
+    return vetoes.end();
+    
+  }
+  
+  template <class T>
+  void VetoSet<T>::addVeto(const Veto<T>& veto){
+    
+    vetoes.push_back(veto.clone());
+
+  }
+  
+  template <class T>
+  void VetoSet<T>::addVeto(std::unique_ptr<Veto<T>> veto){
+    
+    if(veto) vetoes.push_back(std::move(veto));
+
+  }
+  
+  template <class T>
+  void VetoSet<T>::clear(){
+    
+    for(auto& veto : vetoes) veto->clear();
+
+  }
+  
+  template <class T>
+  template <class Vetoable>
+  bool VetoSet<T>::veto(const Vetoable& vetoable) const{
+    
+    return std::any_of(vetoes.begin(), vetoes.end(), [&](const auto& veto){return veto->veto(vetoable);});
+
+  }
+  
+  template <class T>
+  template <class Vetoable>
+  bool VetoSet<T>::veto(const Vetoable& vetoable, CutFlow& cutFlow) const{
+    
+    cutFlow.increment("Input");
+    for(const auto& veto : vetoes){
+      
+      if(veto->veto(vetoable)){
+        
+        cutFlow.increment(veto->getName());
+        return true;
+        
+      }
+      
+    }
+    
+    cutFlow.increment("Selected");
+    return false;
+
+  }
+  
+  template <class T>
+  void VetoSet<T>::print(std::ostream& output) const{
+    
+    for(auto itVeto = vetoes.begin(); itVeto != vetoes.end(); ++itVeto){
+      
+      if(itVeto != vetoes.begin()) output<<"\n";
+      (*itVeto)->print(output);
+      
+    }
+
+  }
+  
+  template <class T>
+  std::ostream& operator<<(std::ostream& output, const VetoSet<T>& vetoSet){
+    
+    vetoSet.print(output);
+    return output;
+
+  }
+
+}
+
+#endif
@@ -3,173 +3,256 @@
 
 #include <iomanip>
 #include <queue>
+#include <memory_resource>
 #include <algorithm>
 #include "cereal/types/deque.hpp"
+#include "Cosmogenic/ClassVersion.hpp"
+#include "Cosmogenic/TriggerTime.hpp"
+#include "Cosmogenic/WindowAggregator.hpp"
 
 namespace CosmogenicHunter{
 
-  template <class T>
+  template <class T, class Aggregator = NoAggregator>//'Aggregator' is kept up to date with the events entering and leaving the window, see WindowAggregator.hpp
   class Window{
     
-    double startTime;
-    double lenght;
-    std::deque<T> events;//class T must implement 'getTriggerTime'
+    using Events = std::pmr::deque<T>;
+    
+    TriggerTime startTime;
+    TriggerTime lenght;
+    Events events;//class T must implement 'getTriggerTime'
+    Aggregator aggregator;
     friend class cereal::access;
     template <class Archive>
-    void serialize(Archive& archive);
-    void eraseTooYoung(double startTime);
-    void eraseTooOld(double startTime, double lenght);
+    void save(Archive& archive, std::uint32_t version) const;
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t version);//the aggregator is not stored but rebuilt from the events
+    void eraseTooYoung(TriggerTime startTime);
+    void eraseTooOld(TriggerTime startTime, TriggerTime lenght);
     
   public:
+    static constexpr std::uint32_t serializationVersion = getTriggerTimeVersion(1);
+    template <class Archive>
+    void loadUnversioned(Archive& archive);//written before the archives were versioned, T must implement 'loadUnversioned' too, see ClassVersion.hpp
+    using allocator_type = std::pmr::polymorphic_allocator<T>;//the events are allocated from its memory resource, and so are their own windows if T is allocator aware (e.g. a Shower)
     Window() = default;
-    Window(double startTime, double lenght);
-    double getStartTime() const;
-    double getEndTime() const;
-    double getLength() const;
+    explicit Window(const allocator_type& allocator);
+    Window(TriggerTime startTime, TriggerTime lenght, const allocator_type& allocator = {});
+    Window(const Window<T, Aggregator>& other) = default;//uses the default memory resource, as standard containers do
+    Window(const Window<T, Aggregator>& other, const allocator_type& allocator);
+    Window(Window<T, Aggregator>&& other) = default;
+    Window(Window<T, Aggregator>&& other, const allocator_type& allocator);
+    Window<T, Aggregator>& operator = (const Window<T, Aggregator>& other) = default;
+    Window<T, Aggregator>& operator = (Window<T, Aggregator>&& other) = default;
+    allocator_type get_allocator() const;
+    TriggerTime getStartTime() const;
+    TriggerTime getEndTime() const;
+    TriggerTime getLength() const;
     unsigned getNumberOfEvents() const;
-    typename std::deque<T>::const_iterator begin() const;
-    typename std::deque<T>::const_iterator end() const;
-    typename std::deque<T>::iterator begin();
-    typename std::deque<T>::iterator end();
+    typename Events::const_iterator begin() const;
+    typename Events::const_iterator end() const;
+    typename Events::iterator begin();//modifying the events through the non const accessors bypasses the aggregator
+    typename Events::iterator end();
     const T& front() const;
     T& front();
     const T& back() const;
     T& back();
-    void setStartTime(double startTime);
-    void setLenght(double lenght);
-    void setEndTime(double endTime);
-    bool covers(double triggerTime) const;//check if the trigger is within the time window (accept events in [startTime, startTime + lenght[ )
+    void setStartTime(TriggerTime startTime);
+    void setLenght(TriggerTime lenght);
+    void setEndTime(TriggerTime endTime);
+    bool covers(TriggerTime triggerTime) const;//check if the trigger is within the time window (accept events in [startTime, startTime + lenght[ )
     template <class K>
     bool covers(const K& event) const;//check if the event is within the time window (event need not be of the same 'event type' as the ones stored in the window)
     bool isEmpty() const;
+    const Aggregator& getAggregator() const;
+    void setAggregator(Aggregator aggregator);//e.g. to configure it, the events already in the window are added to it
     template <class... Args>
-    void emplaceEvent(double triggerTime, Args&&... args);//emplace back the event if it is within the window
+    void emplaceEvent(TriggerTime triggerTime, Args&&... args);//emplace back the event if it is within the window
     template <class BaseClass, class... Args>
     void emplaceEvent(BaseClass eventBase, Args&&... args);//meant for Derived::BaseClass built from a BaseClass that implements 'getTriggerTime'
     void pushBackEvent(const T& event);//push back the event if it is within the window
-    void pushBackEvent(T&& event);//'T&&' is not a 'universal reference' since T has been deduced already at the instantation of Window<T>, so 'T&&' can only bind to rvalue references and not lvalues
+    void pushBackEvent(T&& event);//'T&&' is not a 'universal reference' since T has been deduced already at the instantation of Window<T, Aggregator>, so 'T&&' can only bind to rvalue references and not lvalues
     void clear();//clear all events
+    void reset(TriggerTime startTime, TriggerTime lenght);//clear all events and move the window, keeping the memory of the container when possible (see ObjectPool)
     void print(std::ostream& output, unsigned outputOffset) const;
     
   };
   
-  template <class T>
+  template <class T, class Aggregator>
   template <class Archive>
-  void Window<T>::serialize(Archive& archive){
+  void Window<T, Aggregator>::save(Archive& archive, std::uint32_t) const{
     
     archive(startTime, lenght, events);
 
   }
   
-  template <class T>
-  void Window<T>::eraseTooYoung(double startTime){
+  template <class T, class Aggregator>
+  template <class Archive>
+  void Window<T, Aggregator>::load(Archive& archive, std::uint32_t version){
+    
+    if(version == serializationVersion) archive(startTime, lenght, events);
+    else if(version == getForeignTriggerTimeVersion(1)){
+      
+      loadForeignTriggerTime(archive, startTime);
+      loadForeignTriggerTime(archive, lenght);
+      archive(events);
+      
+    }
+    else throw std::runtime_error(getUnknownVersionMessage<Window<T, Aggregator>>("Window", version));
+    
+    aggregator.clear();
+    for(const auto& event : events) aggregator.add(event);
+
+  }
+  
+  template <class T, class Aggregator>
+  template <class Archive>
+  void Window<T, Aggregator>::loadUnversioned(Archive& archive){
+    
+    loadUnversionedTriggerTime(archive, startTime);
+    loadUnversionedTriggerTime(archive, lenght);
+    cereal::size_type numberOfEvents;
+    archive(cereal::make_size_tag(numberOfEvents));
+    events.resize(numberOfEvents);
+    for(auto& event : events) event.loadUnversioned(archive);
+    
+    aggregator.clear();
+    for(const auto& event : events) aggregator.add(event);
+
+  }
+  
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::eraseTooYoung(TriggerTime startTime){
     
     auto itFirstValid = std::find_if(events.begin(), events.end(), [&](const auto& event){return event.getTriggerTime() >= startTime;});
+    std::for_each(events.begin(), itFirstValid, [&](const auto& event){aggregator.remove(event);});
     events.erase(events.begin(), itFirstValid);
     
   }
   
-  template <class T>
-  void Window<T>::eraseTooOld(double startTime, double lenght){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::eraseTooOld(TriggerTime startTime, TriggerTime lenght){
     
     auto itFirstOld = std::find_if(events.begin(), events.end(), [&](const auto& event){return event.getTriggerTime() >= startTime + lenght;});
+    std::for_each(itFirstOld, events.end(), [&](const auto& event){aggregator.remove(event);});
     events.erase(itFirstOld, events.end());
     
   }
   
-  template <class T>
-  Window<T>::Window(double startTime, double lenght):startTime(startTime),lenght(std::abs(lenght)){
+  template <class T, class Aggregator>
+  Window<T, Aggregator>::Window(const allocator_type& allocator):startTime(0),lenght(0),events(allocator){
     
   }
+  
+  template <class T, class Aggregator>
+  Window<T, Aggregator>::Window(TriggerTime startTime, TriggerTime lenght, const allocator_type& allocator):startTime(startTime),lenght(std::abs(lenght)),events(allocator){
+    
+  }
+  
+  template <class T, class Aggregator>
+  Window<T, Aggregator>::Window(const Window<T, Aggregator>& other, const allocator_type& allocator):startTime(other.startTime),lenght(other.lenght),events(other.events, allocator),aggregator(other.aggregator){
+    
+  }
+  
+  template <class T, class Aggregator>
+  Window<T, Aggregator>::Window(Window<T, Aggregator>&& other, const allocator_type& allocator):startTime(other.startTime),lenght(other.lenght),events(std::move(other.events), allocator),aggregator(std::move(other.aggregator)){
+    
+  }
+  
+  template <class T, class Aggregator>
+  typename Window<T, Aggregator>::allocator_type Window<T, Aggregator>::get_allocator() const{
+    
+    return events.get_allocator();
 
-  template <class T>
-  double Window<T>::getStartTime() const{
+  }
+
+  template <class T, class Aggregator>
+  TriggerTime Window<T, Aggregator>::getStartTime() const{
     
     return startTime;
 
   }
   
-  template <class T>
-  double Window<T>::getEndTime() const{
+  template <class T, class Aggregator>
+  TriggerTime Window<T, Aggregator>::getEndTime() const{
     
     return startTime + lenght;
 
   }
 
-  template <class T>
-  double Window<T>::getLength() const{
+  template <class T, class Aggregator>
+  TriggerTime Window<T, Aggregator>::getLength() const{
     
     return lenght;
 
   }
 
-  template <class T>
-  unsigned Window<T>::getNumberOfEvents() const{
+  template <class T, class Aggregator>
+  unsigned Window<T, Aggregator>::getNumberOfEvents() const{
     
     return events.size();
 
   }
 
-  template <class T>
-  typename std::deque<T>::const_iterator Window<T>::begin() const{
+  template <class T, class Aggregator>
+  typename Window<T, Aggregator>::Events::const_iterator Window<T, Aggregator>::begin() const{
 
     return events.begin();
     
   }
 
-  template <class T>
-  typename std::deque<T>::const_iterator Window<T>::end() const{
+  template <class T, class Aggregator>
+  typename Window<T, Aggregator>::Events::const_iterator Window<T, Aggregator>::end() const{
 
     return events.end();
     
   }
 
-  template <class T>
-  typename std::deque<T>::iterator Window<T>::begin(){
+  template <class T, class Aggregator>
+  typename Window<T, Aggregator>::Events::iterator Window<T, Aggregator>::begin(){
 
     return events.begin();
     
   }
 
-  template <class T>
-  typename std::deque<T>::iterator Window<T>::end(){
+  template <class T, class Aggregator>
+  typename Window<T, Aggregator>::Events::iterator Window<T, Aggregator>::end(){
 
     return events.end();
     
   }
   
-  template <class T>
-  const T& Window<T>::front() const{
+  template <class T, class Aggregator>
+  const T& Window<T, Aggregator>::front() const{
     
     return events.front();
 
   }
   
-  template <class T>
-  T& Window<T>::front(){
+  template <class T, class Aggregator>
+  T& Window<T, Aggregator>::front(){
     
     return events.front();
 
   }
   
-  template <class T>
-  const T& Window<T>::back() const{
+  template <class T, class Aggregator>
+  const T& Window<T, Aggregator>::back() const{
     
     return events.back();
 
   }
   
-  template <class T>
-  T& Window<T>::back(){
+  template <class T, class Aggregator>
+  T& Window<T, Aggregator>::back(){
     
     return events.back();
 
   }
   
-  template <class T>
-  void Window<T>::setStartTime(double startTime){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::setStartTime(TriggerTime startTime){
     
-    if(startTime >= getEndTime()) events.clear();
+    if(startTime >= getEndTime()) clear();
     else if(startTime < getEndTime() && startTime >= this->startTime) eraseTooYoung(startTime);
     else if(startTime < this->startTime) eraseTooOld(startTime, lenght);
     
@@ -177,8 +260,8 @@ namespace CosmogenicHunter{
 
   }
 
-  template <class T>
-  void Window<T>::setLenght(double lenght){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::setLenght(TriggerTime lenght){
     
     if(lenght > 0){
     
@@ -189,74 +272,100 @@ namespace CosmogenicHunter{
 
   }
   
-  template <class T>
-  void Window<T>::setEndTime(double endTime){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::setEndTime(TriggerTime endTime){
     
     setStartTime(endTime - lenght);
 
   }
 
-  template <class T>
-  bool Window<T>::covers(double triggerTime) const{
+  template <class T, class Aggregator>
+  bool Window<T, Aggregator>::covers(TriggerTime triggerTime) const{
 
     return triggerTime >= startTime && triggerTime < startTime + lenght;
 
   }
 
-  template <class T>
+  template <class T, class Aggregator>
   template <class K>
-  bool Window<T>::covers(const K& event) const{
+  bool Window<T, Aggregator>::covers(const K& event) const{
 
     return covers(event.getTriggerTime());
 
   }
 
-  template <class T>
-  bool Window<T>::isEmpty() const{
+  template <class T, class Aggregator>
+  bool Window<T, Aggregator>::isEmpty() const{
     
     return events.empty();
 
   }
 
-  template <class T>
+  template <class T, class Aggregator>
+  const Aggregator& Window<T, Aggregator>::getAggregator() const{
+    
+    return aggregator;
+
+  }
+
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::setAggregator(Aggregator aggregator){
+    
+    this->aggregator = std::move(aggregator);
+    this->aggregator.clear();
+    for(const auto& event : events) this->aggregator.add(event);
+
+  }
+
+  template <class T, class Aggregator>
   template <class... Args>
-  void Window<T>::emplaceEvent(double triggerTime, Args&&... args){
+  void Window<T, Aggregator>::emplaceEvent(TriggerTime triggerTime, Args&&... args){
     
-    if(covers(triggerTime)) events.emplace_back(triggerTime, std::forward<Args>(args)...);
+    if(covers(triggerTime)) aggregator.add(events.emplace_back(triggerTime, std::forward<Args>(args)...));
 
   }
 
-  template <class T>
+  template <class T, class Aggregator>
   template <class BaseClass, class... Args>
-  void Window<T>::emplaceEvent(BaseClass eventBase, Args&&... args){
+  void Window<T, Aggregator>::emplaceEvent(BaseClass eventBase, Args&&... args){
 
-    if(covers(eventBase)) events.emplace_back(std::move(eventBase), std::forward<Args>(args)...);
+    if(covers(eventBase)) aggregator.add(events.emplace_back(std::move(eventBase), std::forward<Args>(args)...));
 
   }
   
-  template <class T>
-  void Window<T>::pushBackEvent(const T& event){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::pushBackEvent(const T& event){
     
-    if(covers(event)) events.push_back(event);
+    if(covers(event)) aggregator.add(events.emplace_back(event));
 
   }
 
-  template <class T>
-  void Window<T>::pushBackEvent(T&& event){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::pushBackEvent(T&& event){
     
-    if(covers(event)) events.push_back(std::move(event));//keep the r-value character with std::move
+    if(covers(event)) aggregator.add(events.emplace_back(std::move(event)));//keep the r-value character with std::move
 
   }
 
-  template <class T>
-  void Window<T>::clear(){
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::clear(){
     
     events.clear();
+    aggregator.clear();
 
   }
   
-  template <class T>
-  void Window<T>::print(std::ostream& output, unsigned outputOffset) const{
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::reset(TriggerTime startTime, TriggerTime lenght){
+    
+    clear();
+    this->startTime = startTime;
+    this->lenght = std::abs(lenght);
+
+  }
+  
+  template <class T, class Aggregator>
+  void Window<T, Aggregator>::print(std::ostream& output, unsigned outputOffset) const{
     
     output<<std::setw(outputOffset)<<std::left<<""<<std::setw(12)<<std::left<<"Start time: "<<std::setw(8)<<std::left<<startTime
       <<std::setw(8)<<std::left<<" Lenght: "<<std::setw(8)<<std::left<<lenght
@@ -272,8 +381,8 @@ namespace CosmogenicHunter{
     
   }
 
-  template <class T>
-  std::ostream& operator<<(std::ostream& output, const Window<T>& window){
+  template <class T, class Aggregator>
+  std::ostream& operator<<(std::ostream& output, const Window<T, Aggregator>& window){
     
     window.print(output, 0);
     return output;
@@ -282,4 +391,6 @@ namespace CosmogenicHunter{
 
 }
 
+COSMOGENIC_CLASS_VERSION(CosmogenicHunter::Window)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef COSMOGENIC_WINDOW_AGGREGATOR_H
+#define COSMOGENIC_WINDOW_AGGREGATOR_H
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Cosmogenic/Event.hpp"
+
+namespace CosmogenicHunter{
+
+  //an aggregator of Window<T, Aggregator> implements 'add(const T&)' and 'remove(const T&)', called as events enter and leave the window, and 'clear()'
+  //extreme trigger times are not aggregated: windows are time ordered, so they are front() and back()
+
+  struct NoAggregator{
+    
+    template <class T>
+    void add(const T&){}
+    template <class T>
+    void remove(const T&){}
+    void clear(){}
+
+  };
+
+  template <class T>
+  class EventStatistics{//visible energy moments and event rate of the events in a window
+
+    unsigned numberOfEvents;
+    double energySum;//accumulated in double whatever T, so that removals do not drift
+    double energySumOfSquares;
+    TriggerTime rateTimeConstant;
+    double decayedRate;//exponentially weighted number of events per unit time, as of 'lastTriggerTime'
+    TriggerTime lastTriggerTime;
+    template <class K>
+    static double getVisibleEnergy(const K& event);//Muon hides Event::getVisibleEnergy
+
+  public:
+    explicit EventStatistics(TriggerTime rateTimeConstant = 1e9);//ns
+    template <class K>
+    void add(const K& event);
+    template <class K>
+    void remove(const K& event);
+    void clear();
+    unsigned getNumberOfEvents() const;
+    T getEnergySum() const;
+    T getEnergySumOfSquares() const;
+    T getMeanEnergy() const;
+    T getEnergyVariance() const;
+    double getRate() const;//events per ns averaged over the last 'rateTimeConstant' before the latest event entered
+    double getRate(TriggerTime triggerTime) const;//same, decayed until 'triggerTime'
+    void print(std::ostream& output, unsigned outputOffset) const;
+
+  };
+
+  template <class T>
+  EventStatistics<T>::EventStatistics(TriggerTime rateTimeConstant):rateTimeConstant(rateTimeConstant){
+    
+    if(rateTimeConstant <= 0) throw std::invalid_argument(std::to_string(rateTimeConstant)+"ns is not a valid rate time constant.");
+    clear();
+
+  }
+
+  template <class T>
+  template <class K>
+  double EventStatistics<T>::getVisibleEnergy(const K& event){
+    
+    if constexpr(std::is_base_of<Event<T>, K>::value) return static_cast<const Event<T>&>(event).getVisibleEnergy();
+    else return event.getVisibleEnergy();
+
+  }
+
+  template <class T>
+  template <class K>
+  void EventStatistics<T>::add(const K& event){
+    
+    double energy = getVisibleEnergy(event);
+    ++numberOfEvents;
+    energySum += energy;
+    energySumOfSquares += energy * energy;
+
+    decayedRate = getRate(event.getTriggerTime()) + 1. / rateTimeConstant;
+    lastTriggerTime = std::max(lastTriggerTime, event.getTriggerTime());
+
+  }
+
+  template <class T>
+  template <class K>
+  void EventStatistics<T>::remove(const K& event){//the rate estimate is driven by arrivals only
+    
+    double energy = getVisibleEnergy(event);
+    if(--numberOfEvents == 0){
+      
+      energySum = 0;
+      energySumOfSquares = 0;
+
+    }
+    else{
+      
+      energySum -= energy;
+      energySumOfSquares -= energy * energy;
+
+    }
+
+  }
+
+  template <class T>
+  void EventStatistics<T>::clear(){
+    
+    numberOfEvents = 0;
+    energySum = 0;
+    energySumOfSquares = 0;
+    decayedRate = 0;
+    lastTriggerTime = std::numeric_limits<TriggerTime>::lowest();
+
+  }
+
+  template <class T>
+  unsigned EventStatistics<T>::getNumberOfEvents() const{
+    
+    return numberOfEvents;
+
+  }
+
+  template <class T>
+  T EventStatistics<T>::getEnergySum() const{
+    
+    return energySum;
+
+  }
+
+  template <class T>
+  T EventStatistics<T>::getEnergySumOfSquares() const{
+    
+    return energySumOfSquares;
+
+  }
+
+  template <class T>
+  T EventStatistics<T>::getMeanEnergy() const{
+    
+    return numberOfEvents > 0 ? energySum / numberOfEvents : 0;
+
+  }
+
+  template <class T>
+  T EventStatistics<T>::getEnergyVariance() const{
+    
+    if(numberOfEvents == 0) return 0;
+    double meanEnergy = energySum / numberOfEvents;
+    return std::max(energySumOfSquares / numberOfEvents - meanEnergy * meanEnergy, 0.);
+
+  }
+
+  template <class T>
+  double EventStatistics<T>::getRate() const{
+    
+    return decayedRate;
+
+  }
+
+  template <class T>
+  double EventStatistics<T>::getRate(TriggerTime triggerTime) const{
+    
+    if(decayedRate == 0 || triggerTime <= lastTriggerTime) return decayedRate;
+    return decayedRate * std::exp(-static_cast<double>(triggerTime - lastTriggerTime) / rateTimeConstant);
+
+  }
+
+  template <class T>
+  void EventStatistics<T>::print(std::ostream& output, unsigned outputOffset) const{
+    
+    output<<std::setw(outputOffset)<<std::left<<""<<"Events: "<<numberOfEvents<<" Energy sum: "<<getEnergySum()<<" Mean energy: "<<getMeanEnergy()<<" Rate: "<<getRate()<<"/ns";
+
+  }
+
+  template <class T>
+  std::ostream& operator<<(std::ostream& output, const EventStatistics<T>& eventStatistics){
+    
+    eventStatistics.print(output, 0);
+    return output;
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef COSMOGENIC_WORK_STEALING_POOL_H
+#define COSMOGENIC_WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+
+namespace CosmogenicHunter{
+
+  class WorkStealingPool{//each worker drains its own queue from the front and steals from the back of the others' when idle, the workers are started once and sleep between calls to 'execute'
+    
+    struct WorkerQueue{
+      
+      std::mutex mutex;
+      std::deque<std::function<void(unsigned)>> tasks;
+      
+    };
+    
+    unsigned numberOfThreads;
+    mutable std::vector<WorkerQueue> queues;
+    mutable std::mutex executeMutex;//one 'execute' at a time, so that a const pool can be shared
+    mutable std::mutex mutex;//guards the members below
+    mutable std::condition_variable workAvailable;
+    mutable std::condition_variable workDone;
+    mutable unsigned long generation;//incremented by each 'execute' to wake the workers
+    mutable unsigned numberOfBusyWorkers;
+    mutable std::exception_ptr firstException;
+    bool stopRequested;
+    std::vector<std::thread> workers;//the calling thread of 'execute' is worker 0
+    bool popOwnTask(WorkerQueue& queue, std::function<void(unsigned)>& task) const;
+    bool stealTask(unsigned thiefIndex, std::function<void(unsigned)>& task) const;
+    void work(unsigned workerIndex) const;//runs tasks until all queues are empty
+    void waitForWork(unsigned workerIndex);
+    void startWorkers();
+    void stopWorkers();
+    
+  public:
+    explicit WorkStealingPool(unsigned numberOfThreads = std::thread::hardware_concurrency());
+    WorkStealingPool(const WorkStealingPool& other);//a new pool with as many threads, e.g. for the copies of a WorkerState owning a pool
+    WorkStealingPool& operator = (const WorkStealingPool& other);
+    ~WorkStealingPool();
+    unsigned getNumberOfThreads() const;
+    void execute(std::vector<std::function<void(unsigned)>> tasks) const;//tasks receive the index of the worker running them, they are dealt in order so that the first ones start first, and must not call 'execute' on the same pool
+    
+  };
+  
+  inline bool WorkStealingPool::popOwnTask(WorkerQueue& queue, std::function<void(unsigned)>& task) const{
+    
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(queue.tasks.empty()) return false;
+    
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+
+  }
+  
+  inline bool WorkStealingPool::stealTask(unsigned thiefIndex, std::function<void(unsigned)>& task) const{
+    
+    for(unsigned k = 1; k < queues.size(); ++k){
+      
+      auto& victim = queues[(thiefIndex + k) % queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if(!victim.tasks.empty()){
+        
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return true;
+        
+      }
+      
+    }
+    
+    return false;
+
+  }
+  
+  inline void WorkStealingPool::work(unsigned workerIndex) const{
+    
+    std::function<void(unsigned)> task;
+    while(popOwnTask(queues[workerIndex], task) || stealTask(workerIndex, task)){
+      
+      try{
+        
+        task(workerIndex);
+        
+      }
+      catch(...){
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!firstException) firstException = std::current_exception();
+        
+      }
+      
+    }
+
+  }
+  
+  inline void WorkStealingPool::waitForWork(unsigned workerIndex){
+    
+    unsigned long lastGeneration = 0;
+    while(true){
+      
+      {
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        workAvailable.wait(lock, [&](){return stopRequested || generation != lastGeneration;});
+        if(stopRequested) return;
+        lastGeneration = generation;
+        
+      }
+      
+      work(workerIndex);
+      
+      bool isLastWorker;
+      {
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        isLastWorker = --numberOfBusyWorkers == 0;
+        
+      }
+      if(isLastWorker) workDone.notify_one();
+      
+    }
+
+  }
+  
+  inline void WorkStealingPool::startWorkers(){
+    
+    queues = std::vector<WorkerQueue>(numberOfThreads);
+    generation = 0;
+    numberOfBusyWorkers = 0;
+    stopRequested = false;
+    for(unsigned workerIndex = 1; workerIndex < numberOfThreads; ++workerIndex) workers.emplace_back(&WorkStealingPool::waitForWork, this, workerIndex);
+
+  }
+  
+  inline void WorkStealingPool::stopWorkers(){
+    
+    {
+      
+      std::lock_guard<std::mutex> lock(mutex);
+      stopRequested = true;
+      
+    }
+    workAvailable.notify_all();
+    for(auto& worker : workers) worker.join();
+    workers.clear();
+
+  }
+  
+  inline WorkStealingPool::WorkStealingPool(unsigned numberOfThreads):numberOfThreads(std::max(numberOfThreads, 1u)){
+    
+    startWorkers();
+
+  }
+  
+  inline WorkStealingPool::WorkStealingPool(const WorkStealingPool& other):WorkStealingPool(other.numberOfThreads){
+    
+  }
+  
+  inline WorkStealingPool& WorkStealingPool::operator = (const WorkStealingPool& other){
+    
+    if(numberOfThreads != other.numberOfThreads){
+      
+      std::lock_guard<std::mutex> executeLock(executeMutex);
+      stopWorkers();
+      numberOfThreads = other.numberOfThreads;
+      startWorkers();
+      
+    }
+    return *this;
+
+  }
+  
+  inline WorkStealingPool::~WorkStealingPool(){
+    
+    stopWorkers();
+
+  }
+  
+  inline unsigned WorkStealingPool::getNumberOfThreads() const{
+    
+    return numberOfThreads;
+
+  }
+  
+  inline void WorkStealingPool::execute(std::vector<std::function<void(unsigned)>> tasks) const{
+    
+    std::lock_guard<std::mutex> executeLock(executeMutex);
+    for(unsigned k = 0; k < tasks.size(); ++k) queues[k % numberOfThreads].tasks.push_back(std::move(tasks[k]));//tasks never spawn tasks, so all queues empty means all work is done
+    
+    if(numberOfThreads > 1){
+      
+      {
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        numberOfBusyWorkers = numberOfThreads - 1;
+        
+      }
+      workAvailable.notify_all();
+      
+    }
+    
+    work(0);
+    
+    std::exception_ptr exception;
+    {
+      
+      std::unique_lock<std::mutex> lock(mutex);
+      workDone.wait(lock, [&](){return numberOfBusyWorkers == 0;});
+      std::swap(exception, firstException);
+      
+    }
+    
+    if(exception) std::rethrow_exception(exception);
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef COSMOGENIC_WORKER_STATE_POOL_H
+#define COSMOGENIC_WORKER_STATE_POOL_H
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include <string>
+
+namespace CosmogenicHunter{
+
+  template <class WorkerState>
+  class WorkerStatePool{//one copy of a prototype (e.g. a VetoSet, which clones its vetoes when copied) per worker, made on first use and reused by all the later tasks of that worker
+
+    WorkerState prototype;
+    std::vector<std::unique_ptr<WorkerState>> workerStates;//each slot is only touched by its own worker
+
+  public:
+    WorkerStatePool(WorkerState prototype, unsigned numberOfWorkers);
+    const WorkerState& getPrototype() const;
+    void setPrototype(WorkerState prototype);//drops the copies of the previous prototype
+    unsigned getNumberOfWorkers() const;
+    unsigned getNumberOfCopies() const;
+    WorkerState& get(unsigned workerIndex);
+
+  };
+
+  template <class WorkerState>
+  WorkerStatePool<WorkerState>::WorkerStatePool(WorkerState prototype, unsigned numberOfWorkers)
+  :prototype(std::move(prototype)),workerStates(numberOfWorkers){
+  
+  }
+
+  template <class WorkerState>
+  const WorkerState& WorkerStatePool<WorkerState>::getPrototype() const{
+    
+    return prototype;
+
+  }
+
+  template <class WorkerState>
+  void WorkerStatePool<WorkerState>::setPrototype(WorkerState prototype){
+    
+    this->prototype = std::move(prototype);
+    for(auto& workerState : workerStates) workerState.reset();
+
+  }
+
+  template <class WorkerState>
+  unsigned WorkerStatePool<WorkerState>::getNumberOfWorkers() const{
+    
+    return workerStates.size();
+
+  }
+
+  template <class WorkerState>
+  unsigned WorkerStatePool<WorkerState>::getNumberOfCopies() const{
+    
+    unsigned numberOfCopies = 0;
+    for(const auto& workerState : workerStates) if(workerState) ++numberOfCopies;
+    return numberOfCopies;
+
+  }
+
+  template <class WorkerState>
+  WorkerState& WorkerStatePool<WorkerState>::get(unsigned workerIndex){
+    
+    if(workerIndex >= workerStates.size()) throw std::out_of_range(std::to_string(workerIndex)+" is not a valid worker index.");
+
+    auto& workerState = workerStates[workerIndex];
+    if(!workerState) workerState = std::make_unique<WorkerState>(prototype);//built by the worker itself, so that idle workers do not pay for it
+    return *workerState;
+
+  }
+
+}
+
+#endif
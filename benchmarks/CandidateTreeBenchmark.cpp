@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "Cosmogenic/CandidateTree.hpp"
+#include "Cosmogenic/RunArena.hpp"
+#include "Cosmogenic/ToyGenerator.hpp"
+
+template <class T>
+using MuonShower = CosmogenicHunter::Shower<CosmogenicHunter::Muon<T>, CosmogenicHunter::Single<T>>;
+
+template <class T, class TreeFactory>
+void benchmark(const std::string& name, const std::vector<MuonShower<T>>& showers, const std::vector<CosmogenicHunter::Single<T>>& singles, CosmogenicHunter::TriggerTime muonWindowLenght, unsigned numberOfRepetitions, TreeFactory buildTree){//the prompts are all the singles, the delayed their next single
+  
+  using namespace CosmogenicHunter;
+  unsigned long numberOfShowers = 0, numberOfFollowers = 0;
+  double duration = 0;
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition){
+    
+    Window<MuonShower<T>> muonShowers(singles.front().getTriggerTime() - muonWindowLenght, muonWindowLenght);
+    SharedWindow<MuonShower<T>> sharedMuonShowers(singles.front().getTriggerTime() - muonWindowLenght, muonWindowLenght);
+    auto itShower = showers.begin();
+    for(unsigned k = 0; k + 1 < singles.size(); ++k){
+      
+      const auto& prompt = singles[k];
+      muonShowers.setEndTime(prompt.getTriggerTime());
+      sharedMuonShowers.setEndTime(prompt.getTriggerTime());
+      for(; itShower != showers.end() && itShower->getTriggerTime() < prompt.getTriggerTime(); ++itShower){
+        
+        muonShowers.pushBackEvent(*itShower);
+        sharedMuonShowers.pushBackEvent(*itShower);
+        
+      }
+      
+      auto start = std::chrono::steady_clock::now();//only the construction and destruction of the tree
+      {
+        
+        auto candidateTree = buildTree(CandidatePair<T>(prompt, singles[k + 1]), muonShowers, sharedMuonShowers);
+        numberOfShowers += candidateTree.getMuonShowers().getNumberOfEvents();
+        for(const auto& shower : candidateTree.getMuonShowers()) numberOfFollowers += shower.getNumberOfFollowers();
+        
+      }
+      duration += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      
+    }
+    
+  }
+  
+  double numberOfTrees = static_cast<double>(singles.size() - 1) * numberOfRepetitions;
+  double numberOfBytes = numberOfTrees * sizeof(CandidatePair<T>) + numberOfShowers * sizeof(MuonShower<T>) + numberOfFollowers * sizeof(Single<T>);//held by the trees, whether copied or shared
+  std::cout<<"  "<<std::setw(7)<<std::left<<name<<std::setw(8)<<std::right<<muonWindowLenght * 1e-9<<" s   "
+    <<std::setw(10)<<std::right<<numberOfTrees / duration * 1e-6<<" Mtrees/s   "
+    <<std::setw(10)<<std::right<<numberOfBytes / duration * 1e-6<<" MB/s   "
+    <<"showers per tree: "<<numberOfShowers / numberOfTrees<<"\n";
+  
+}
+
+template <class T>
+void benchmark(double runDuration, unsigned numberOfRepetitions){
+  
+  using namespace CosmogenicHunter;
+  auto run = ToyGenerator<T,T>().generate(runDuration * 1e9, 0);
+  std::cout<<(sizeof(T) == sizeof(float) ? "float" : "double")<<": "<<run.muons.size()<<" muons, "<<run.singles.size()<<" singles\n";
+  
+  Bounds<TriggerTime> followerTimeBounds(0, 1e6);
+  std::vector<MuonShower<T>> showers;
+  auto itFirstSingle = run.singles.begin();
+  for(const auto& muon : run.muons){
+    
+    showers.emplace_back(muon, followerTimeBounds);
+    for(; itFirstSingle != run.singles.end() && itFirstSingle->getTriggerTime() < muon.getTriggerTime(); ++itFirstSingle);
+    for(auto itSingle = itFirstSingle; itSingle != run.singles.end() && showers.back().getFollowerWindow().covers(*itSingle); ++itSingle) showers.back().pushBackFollower(*itSingle);
+    
+  }
+  
+  RunArena runArena;
+  unsigned numberOfArenaTrees = 0;
+  for(double muonWindowLenght : {1e8, 1e9, 1e10}){
+    
+    benchmark("copy", showers, run.singles, muonWindowLenght, numberOfRepetitions, [](CandidatePair<T> candidatePair, const auto& muonShowers, const auto&){
+      
+      return CandidateTree<T,T>(std::move(candidatePair), muonShowers);
+      
+    });
+    benchmark("arena", showers, run.singles, muonWindowLenght, numberOfRepetitions, [&](CandidatePair<T> candidatePair, const auto& muonShowers, const auto&){
+      
+      if(++numberOfArenaTrees % 1024 == 0) runArena.reset();//the previous trees are destroyed
+      return CandidateTree<T,T>(std::move(candidatePair), muonShowers, runArena.getAllocator<MuonShower<T>>());
+      
+    });
+    benchmark("shared", showers, run.singles, muonWindowLenght, numberOfRepetitions, [](CandidatePair<T> candidatePair, const auto&, const auto& sharedMuonShowers){
+      
+      return CandidateTree<T,T>(std::move(candidatePair), sharedMuonShowers);
+      
+    });
+    
+  }
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  double runDuration = argc > 1 ? std::stod(argv[1]) : 3600;//s of toy run
+  unsigned numberOfRepetitions = argc > 2 ? std::stoul(argv[2]) : 3;
+  
+  benchmark<float>(runDuration, numberOfRepetitions);
+  benchmark<double>(runDuration, numberOfRepetitions);
+  
+}
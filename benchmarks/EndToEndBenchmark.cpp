@@ -0,0 +1,292 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <sys/resource.h>
+#include "cereal/archives/binary.hpp"
+#include "Cosmogenic/ToyGenerator.hpp"
+#include "Cosmogenic/OnlineTreeBuilder.hpp"
+#include "Cosmogenic/RunOutput.hpp"
+#include "Cosmogenic/RunDriver.hpp"
+#include "Cosmogenic/VetoSet.hpp"
+#include "Cosmogenic/LightNoiseVeto.hpp"
+#include "Cosmogenic/InnerVeto.hpp"
+#include "Cosmogenic/ChimneyVeto.hpp"
+#include "Cosmogenic/ReconstructionVeto.hpp"
+#include "Cosmogenic/BufferMuonVeto.hpp"
+#include "Cosmogenic/AfterMuonVeto.hpp"
+#include "Cosmogenic/ObjectPool.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Profile{//named workload, reproducible with the same seed
+  
+  std::string name;
+  CosmogenicHunter::ToyParameters parameters;
+  double runDuration;//s
+  
+};
+
+std::vector<Profile> getProfiles(){
+  
+  CosmogenicHunter::ToyParameters farDetector;
+  farDetector.ibdRate = 5e-11;//well above a reactor rate, so that enough pairs survive the after muon veto to time the vetoes and the output
+  
+  auto nearDetector = farDetector;//shallower: more muons and more singles
+  nearDetector.muonRate = 240e-9;
+  nearDetector.accidentalRate = 20e-9;
+  nearDetector.lightNoiseRate = 10e-9;
+  nearDetector.ibdRate = 2e-10;//closer to the reactors
+  
+  auto showeringHeavy = farDetector;//long follower lists and many cosmogenic pairs
+  showeringHeavy.showeringProbability = 0.3;
+  showeringHeavy.neutronsPerShoweringMuon = 20;
+  for(auto& isotope : showeringHeavy.isotopes){
+    
+    isotope.yieldPerMuon *= 10;
+    isotope.yieldPerShoweringMuon *= 10;
+    
+  }
+  
+  return {{"far", farDetector, 3600}, {"near", nearDetector, 1800}, {"showering", showeringHeavy, 3600}};
+  
+}
+
+class CountingBuffer : public std::streambuf{//counts the bytes written and forwards them, or drops them if there is no destination
+  
+  std::streambuf* destination;
+  std::size_t numberOfBytes;
+
+protected:
+  std::streamsize xsputn(const char* characters, std::streamsize count) override{
+    
+    numberOfBytes += count;
+    return destination ? destination->sputn(characters, count) : count;
+    
+  }
+  
+  int_type overflow(int_type character) override{
+    
+    if(traits_type::eq_int_type(character, traits_type::eof())) return traits_type::not_eof(character);
+    ++numberOfBytes;
+    return destination ? destination->sputc(traits_type::to_char_type(character)) : character;
+    
+  }
+
+public:
+  explicit CountingBuffer(std::streambuf* destination):destination(destination),numberOfBytes(0){
+    
+  }
+  
+  std::size_t getNumberOfBytes() const{
+    
+    return numberOfBytes;
+    
+  }
+  
+};
+
+struct Stage{
+  
+  std::string name;
+  double duration;//s
+  double numberOfEvents;
+  double numberOfBytes;
+  unsigned long numberOfTrees;//handled by the stage
+  
+};
+
+struct RunSummary{
+  
+  std::vector<Stage> stages;
+  unsigned long numberOfTrees;
+  unsigned long numberOfTreesAfterMuonVeto;//given to the veto set
+  unsigned long numberOfSelectedTrees;
+  
+};
+
+template <class T>
+class RunProcessor{//what one worker needs to process runs one after the other, copied per worker by RunDriver
+  
+  CosmogenicHunter::VetoSet<T> vetoSet;
+  CosmogenicHunter::AfterMuonVeto<T> afterMuonVeto;
+  CosmogenicHunter::ObjectPool<CosmogenicHunter::Shower<CosmogenicHunter::Muon<T>, CosmogenicHunter::Single<T>>> showerPool;//the showers of the previous runs, with their follower windows
+
+public:
+  RunProcessor();
+  void clear();//called by RunDriver before each run
+  RunSummary process(const CosmogenicHunter::ToyRun<T,T>& run, std::streambuf* destination);//the archive is dropped without 'destination'
+  
+};
+
+template <class T>
+RunProcessor<T>::RunProcessor():afterMuonVeto(1e6, 5e8, 2000, 6e7, 2){
+  
+  using namespace CosmogenicHunter;
+  vetoSet.addVeto(LightNoiseVeto<T>(464, 8, 3e4, 0.12, 36));
+  vetoSet.addVeto(InnerVeto<T>(400, 2, Bounds<T>(-110, 50), 3700));
+  vetoSet.addVeto(ChimneyVeto<T>(1));
+  vetoSet.addVeto(ReconstructionVeto<T>(0.068, 0.88));
+  vetoSet.addVeto(BufferMuonVeto<T>(0.1, 0.1));
+  
+}
+
+template <class T>
+void RunProcessor<T>::clear(){
+  
+  vetoSet.clear();
+  afterMuonVeto.clear();
+  
+}
+
+template <class T>
+RunSummary RunProcessor<T>::process(const CosmogenicHunter::ToyRun<T,T>& run, std::streambuf* destination){
+  
+  using namespace CosmogenicHunter;
+  RunSummary summary;
+  double numberOfEvents = run.muons.size() + run.singles.size();
+  double numberOfBytes = run.muons.size() * sizeof(Muon<T>) + run.singles.size() * sizeof(Single<T>);
+  
+  std::vector<CandidateTree<T,T>> candidateTrees;//windowing, shower building and pair finding
+  OnlineTreeBuilder<T,T> treeBuilder(1e9, Bounds<TriggerTime>(0, 1e6), Bounds<TriggerTime>(500, 150e3), [&](CandidateTree<T,T> candidateTree){candidateTrees.push_back(std::move(candidateTree));}, [](const CandidatePair<T>& candidatePair){
+    
+    return candidatePair.getPrompt().hasVisibleEnergyWithin(Bounds<T>(0.5, 20)) && candidatePair.getDelayed().hasVisibleEnergyWithin(Bounds<T>(4, 10)) && candidatePair.isSpaceCorrelated(1000);
+    
+  });
+  treeBuilder.setShowerPool(&showerPool);
+  auto start = Clock::now();
+  auto itMuon = run.muons.begin();
+  auto itSingle = run.singles.begin();
+  while(itMuon != run.muons.end() || itSingle != run.singles.end()){//the identifiers give the time order of both streams
+    
+    if(itSingle == run.singles.end() || (itMuon != run.muons.end() && itMuon->getIdentifier() < itSingle->getIdentifier())) treeBuilder.pushMuon(*itMuon++);
+    else treeBuilder.pushSingle(*itSingle++);
+    
+  }
+  treeBuilder.flush();
+  summary.stages.push_back(Stage{"trees", std::chrono::duration<double>(Clock::now() - start).count(), numberOfEvents, numberOfBytes, candidateTrees.size()});
+  summary.numberOfTrees = candidateTrees.size();
+  
+  RunOutput<T,T> runOutput;
+  summary.numberOfTreesAfterMuonVeto = 0;
+  start = Clock::now();
+  itMuon = run.muons.begin();
+  for(auto& candidateTree : candidateTrees){//in prompt order
+    
+    const auto& candidatePair = candidateTree.getCandidatePair();
+    for(; itMuon != run.muons.end() && itMuon->getTriggerTime() <= candidatePair.getDelayed().getTriggerTime(); ++itMuon) afterMuonVeto.addMuon(*itMuon);
+    if(afterMuonVeto.veto(candidatePair)){
+      
+      runOutput.cutFlow.increment("Input");
+      runOutput.cutFlow.increment(afterMuonVeto.getName());
+      
+    }
+    else{
+      
+      ++summary.numberOfTreesAfterMuonVeto;
+      if(!vetoSet.veto(candidatePair, runOutput.cutFlow)) runOutput.candidateTrees.push_back(std::move(candidateTree));
+      
+    }
+    afterMuonVeto.eraseBefore(candidatePair.getPrompt().getTriggerTime() - afterMuonVeto.getShoweringMuonVetoTime());
+    
+  }
+  summary.stages.push_back(Stage{"vetoes", std::chrono::duration<double>(Clock::now() - start).count(), static_cast<double>(candidateTrees.size()), static_cast<double>(candidateTrees.size() * sizeof(CandidatePair<T>)), candidateTrees.size()});
+  summary.numberOfSelectedTrees = runOutput.candidateTrees.size();
+  
+  CountingBuffer buffer(destination);
+  start = Clock::now();
+  {
+    
+    std::ostream output(&buffer);
+    cereal::BinaryOutputArchive archive(output);
+    archive(runOutput);
+    
+  }
+  if(destination) destination->pubsync();
+  summary.stages.push_back(Stage{"output", std::chrono::duration<double>(Clock::now() - start).count(), static_cast<double>(runOutput.candidateTrees.size()), static_cast<double>(buffer.getNumberOfBytes()), runOutput.candidateTrees.size()});
+  
+  return summary;
+  
+}
+
+double getPeakMemory(){//MB of resident memory since the start of the process
+  
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss * 1e-6;//bytes
+#else
+  return usage.ru_maxrss * 1e-3;//kB
+#endif
+  
+}
+
+void printReport(const Profile& profile, std::uint64_t seed, unsigned numberOfThreads, const CosmogenicHunter::ToyRun<float,float>& run, const RunSummary& summary, double runsPerHour){//one JSON object per line
+  
+  std::cout<<std::setprecision(6)<<"{\"profile\": \""<<profile.name<<"\", \"seed\": "<<seed<<", \"threads\": "<<numberOfThreads<<", \"runDuration\": "<<profile.runDuration
+    <<", \"muons\": "<<run.muons.size()<<", \"singles\": "<<run.singles.size()<<", \"trees\": "<<summary.numberOfTrees<<", \"treesAfterMuonVeto\": "<<summary.numberOfTreesAfterMuonVeto<<", \"selectedTrees\": "<<summary.numberOfSelectedTrees<<", \"stages\": [";
+  for(const auto& stage : summary.stages){
+    
+    if(&stage != &summary.stages.front()) std::cout<<", ";
+    std::cout<<"{\"name\": \""<<stage.name<<"\", \"trees\": "<<stage.numberOfTrees<<", \"seconds\": "<<stage.duration<<", \"eventsPerSecond\": "<<stage.numberOfEvents / stage.duration<<", \"bytesPerSecond\": "<<stage.numberOfBytes / stage.duration<<"}";
+    
+  }
+  std::cout<<"], \"runsPerHour\": "<<runsPerHour<<", \"peakMemoryMB\": "<<getPeakMemory()<<"}"<<std::endl;
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  using namespace CosmogenicHunter;
+  std::string profileName = argc > 1 ? argv[1] : "all";//the peak memory is the one of the process, run one profile per process to get it per profile
+  std::uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 0;
+  unsigned numberOfThreads = argc > 3 ? std::stoul(argv[3]) : std::thread::hardware_concurrency();
+  std::string outputDirectory = argc > 4 ? argv[4] : "";//archives are only counted if empty
+  
+  bool isKnownProfile = false;
+  for(const auto& profile : getProfiles()){
+    
+    if(profileName != "all" && profileName != profile.name) continue;
+    isKnownProfile = true;
+    
+    ToyGenerator<float,float> generator(profile.parameters, 1e9, numberOfThreads);
+    auto start = Clock::now();
+    std::vector<ToyRun<float,float>> runs;
+    runs.push_back(generator.generate(profile.runDuration * 1e9, seed));
+    double generationDuration = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    auto getOutputPath = [&](std::uint64_t runSeed){return outputDirectory + "/" + profile.name + "_" + std::to_string(runSeed) + ".bin";};
+    auto process = [&](RunProcessor<float>& runProcessor, const ToyRun<float,float>& run, std::uint64_t runSeed){
+      
+      std::filebuf file;
+      if(!outputDirectory.empty() && !file.open(getOutputPath(runSeed), std::ios::out | std::ios::binary)) throw std::runtime_error("Cannot write "+getOutputPath(runSeed)+".");
+      return runProcessor.process(run, outputDirectory.empty() ? nullptr : &file);
+      
+    };
+    RunSummary summary;
+    {
+      
+      RunProcessor<float> runProcessor;//gone before the driver starts, with the showers its pool kept
+      summary = process(runProcessor, runs.front(), seed);
+      
+    }
+    summary.stages.insert(summary.stages.begin(), Stage{"generation", generationDuration, static_cast<double>(runs.front().muons.size() + runs.front().singles.size()), static_cast<double>(runs.front().muons.size() * sizeof(Muon<float>) + runs.front().singles.size() * sizeof(Single<float>)), 0});
+    
+    for(unsigned k = 1; k < numberOfThreads; ++k) runs.push_back(generator.generate(profile.runDuration * 1e9, seed + k));//one run per worker, processed in parallel as on a node
+    RunDriver<RunProcessor<float>> runDriver(RunProcessor<float>(), numberOfThreads);
+    start = Clock::now();
+    runDriver.process(runs, [](const auto& run){return run.singles.size();}, [&](RunProcessor<float>& workerRunProcessor, const ToyRun<float,float>& run){return process(workerRunProcessor, run, seed + (&run - runs.data())).numberOfSelectedTrees;});
+    double runsPerHour = runs.size() / std::chrono::duration<double>(Clock::now() - start).count() * 3600;
+    
+    printReport(profile, seed, numberOfThreads, runs.front(), summary, runsPerHour);
+    
+  }
+  
+  if(!isKnownProfile){
+    
+    std::cerr<<profileName<<" is not a valid profile, use all, far, near or showering.\n";
+    return 1;
+    
+  }
+  
+}
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include "Cosmogenic/MuonDefinition.hpp"
+
+template <class T>
+void benchmark(unsigned numberOfEntries, unsigned numberOfRepetitions){
+  
+  CosmogenicHunter::MuonDefinition<T> muonDefinition(1e4, 600, 3e4);
+  
+  std::mt19937 generator(0);
+  std::exponential_distribution<T> IVChargeDistribution(1e-4), energyDistribution(1e-2);
+  std::vector<T> IVCharges(numberOfEntries), IDCharges(numberOfEntries), energies(numberOfEntries);
+  for(unsigned k = 0; k < numberOfEntries; ++k){
+    
+    IVCharges[k] = IVChargeDistribution(generator);
+    energies[k] = energyDistribution(generator);
+    IDCharges[k] = muonDefinition.getIDCharge(energies[k]);
+    
+  }
+  
+  std::vector<std::uint8_t> scalarMask(numberOfEntries), batchMask(numberOfEntries);
+  std::vector<std::size_t> muonIndices;
+  
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    for(unsigned k = 0; k < numberOfEntries; ++k) scalarMask[k] = muonDefinition.tag(IVCharges[k], IDCharges[k], energies[k]);
+  std::chrono::duration<double> scalarDuration = std::chrono::steady_clock::now() - start;
+  
+  start = std::chrono::steady_clock::now();
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition) muonDefinition.tag(numberOfEntries, IVCharges.data(), IDCharges.data(), energies.data(), batchMask.data(), muonIndices);
+  std::chrono::duration<double> batchDuration = std::chrono::steady_clock::now() - start;
+  
+  if(scalarMask != batchMask) throw std::logic_error("Scalar and batch muon tags differ.");
+  
+  double numberOfTags = static_cast<double>(numberOfEntries) * numberOfRepetitions;
+  std::cout<<std::setw(7)<<std::left<<(sizeof(T) == sizeof(float) ? "float" : "double")
+    <<"scalar: "<<std::setw(10)<<std::right<<numberOfTags / scalarDuration.count() * 1e-6<<" Mentries/s   "
+    <<"batch: "<<std::setw(10)<<std::right<<numberOfTags / batchDuration.count() * 1e-6<<" Mentries/s   "
+    <<"muons: "<<muonIndices.size()<<"\n";
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  unsigned numberOfEntries = argc > 1 ? std::stoul(argv[1]) : 1u << 20;
+  unsigned numberOfRepetitions = argc > 2 ? std::stoul(argv[2]) : 20;
+  
+  benchmark<float>(numberOfEntries, numberOfRepetitions);
+  benchmark<double>(numberOfEntries, numberOfRepetitions);
+  
+}
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "Cosmogenic/ToyGenerator.hpp"
+
+template <class T>
+T getProjectedDistance(const CosmogenicHunter::Segment<T>& track, const CosmogenicHunter::Point<T>& point){//alternative to Heron's formula
+  
+  const auto& startPoint = track.getStartPoint();
+  const auto& endPoint = track.getEndPoint();
+  T directionX = endPoint.getX() - startPoint.getX(), directionY = endPoint.getY() - startPoint.getY(), directionZ = endPoint.getZ() - startPoint.getZ();
+  T dx = point.getX() - startPoint.getX(), dy = point.getY() - startPoint.getY(), dz = point.getZ() - startPoint.getZ();
+  
+  auto projection = dx * directionX + dy * directionY + dz * directionZ;
+  auto squaredDistance = dx * dx + dy * dy + dz * dz - projection * projection / (directionX * directionX + directionY * directionY + directionZ * directionZ);
+  return std::sqrt(std::max(T(0), squaredDistance));
+  
+}
+
+template <class T, class Distance>
+double benchmark(const std::string& name, const std::vector<CosmogenicHunter::Segment<T>>& tracks, const std::vector<CosmogenicHunter::Point<T>>& points, std::vector<T>& distances, Distance getDistance){
+  
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned k = 0; k < tracks.size(); ++k)
+    for(unsigned l = 0; l < points.size(); ++l) distances[k * points.size() + l] = getDistance(tracks[k], points[l]);
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  
+  double numberOfDistances = static_cast<double>(tracks.size()) * points.size();
+  std::cout<<std::setw(7)<<std::left<<(sizeof(T) == sizeof(float) ? "float" : "double")<<std::setw(11)<<std::left<<name
+    <<std::setw(10)<<std::right<<numberOfDistances / duration.count() * 1e-6<<" Mdistances/s   "
+    <<std::setw(10)<<std::right<<numberOfDistances * sizeof(CosmogenicHunter::Point<T>) / duration.count() * 1e-6<<" MB/s\n";
+  return duration.count();
+  
+}
+
+template <class T>
+void benchmark(unsigned numberOfTracks, unsigned numberOfPoints){
+  
+  auto run = CosmogenicHunter::ToyGenerator<T,T>().generate(3600e9, 0);
+  std::vector<CosmogenicHunter::Segment<T>> tracks;
+  std::vector<CosmogenicHunter::Point<T>> points;
+  for(unsigned k = 0; k < numberOfTracks; ++k) tracks.push_back(run.muons[k % run.muons.size()].getTrack());
+  for(unsigned k = 0; k < numberOfPoints; ++k) points.push_back(run.singles[k % run.singles.size()].getPositionInformation().getPosition());
+  
+  std::vector<T> heronDistances(tracks.size() * points.size()), projectedDistances(tracks.size() * points.size());
+  benchmark("Heron", tracks, points, heronDistances, [](const auto& track, const auto& point){return track.getDistanceTo(point);});
+  benchmark("projection", tracks, points, projectedDistances, [](const auto& track, const auto& point){return getProjectedDistance(track, point);});
+  
+  T maxDifference = 0;
+  for(unsigned k = 0; k < heronDistances.size(); ++k) maxDifference = std::max(maxDifference, std::abs(heronDistances[k] - projectedDistances[k]));
+  std::cout<<std::setw(7)<<std::left<<""<<"max difference: "<<maxDifference<<" mm\n";
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  unsigned numberOfTracks = argc > 1 ? std::stoul(argv[1]) : 1000;
+  unsigned numberOfPoints = argc > 2 ? std::stoul(argv[2]) : 4096;//e.g. the singles following a muon
+  
+  benchmark<float>(numberOfTracks, numberOfPoints);
+  benchmark<double>(numberOfTracks, numberOfPoints);
+  
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include "cereal/archives/binary.hpp"
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/CandidateTree.hpp"
+#include "Cosmogenic/ToyGenerator.hpp"
+
+template <class Object>
+void benchmark(const std::string& name, const std::vector<Object>& objects, unsigned numberOfRepetitions){//round trip through a binary archive in memory
+  
+  std::string buffer;
+  std::vector<Object> readObjects;
+  double saveDuration = 0, loadDuration = 0;
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition){
+    
+    std::ostringstream output;
+    auto start = std::chrono::steady_clock::now();
+    {
+      
+      cereal::BinaryOutputArchive outputArchive(output);
+      outputArchive(objects);
+      
+    }
+    saveDuration += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    buffer = output.str();
+    
+    std::istringstream input(buffer);
+    start = std::chrono::steady_clock::now();
+    {
+      
+      cereal::BinaryInputArchive inputArchive(input);
+      inputArchive(readObjects);
+      
+    }
+    loadDuration += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+  }
+  
+  if(readObjects.size() != objects.size()) throw std::logic_error("The "+name+" read back differ from the saved ones.");
+  
+  double numberOfObjects = static_cast<double>(objects.size()) * numberOfRepetitions, numberOfBytes = static_cast<double>(buffer.size()) * numberOfRepetitions;
+  std::cout<<"  "<<std::setw(9)<<std::left<<name
+    <<"save: "<<std::setw(10)<<std::right<<numberOfObjects / saveDuration * 1e-6<<" Mevents/s "<<std::setw(10)<<std::right<<numberOfBytes / saveDuration * 1e-6<<" MB/s   "
+    <<"load: "<<std::setw(10)<<std::right<<numberOfObjects / loadDuration * 1e-6<<" Mevents/s "<<std::setw(10)<<std::right<<numberOfBytes / loadDuration * 1e-6<<" MB/s   "
+    <<"bytes per event: "<<static_cast<double>(buffer.size()) / objects.size()<<"\n";
+  
+}
+
+template <class T>
+void benchmark(double runDuration, unsigned numberOfRepetitions){
+  
+  using namespace CosmogenicHunter;
+  auto run = ToyGenerator<T,T>().generate(runDuration * 1e9, 0);
+  std::cout<<(sizeof(T) == sizeof(float) ? "float" : "double")<<": "<<run.muons.size()<<" muons, "<<run.singles.size()<<" singles\n";
+  
+  Bounds<TriggerTime> followerTimeBounds(0, 1e6);
+  TriggerTime muonWindowLenght = 1e9;
+  std::vector<CandidateTree<T,T>> candidateTrees;//each single with its next one, so that most trees share their showers with the previous one
+  SharedWindow<Shower<Muon<T>, Single<T>>> muonShowers(run.singles.front().getTriggerTime() - muonWindowLenght, muonWindowLenght);
+  auto itMuon = run.muons.begin();
+  for(unsigned k = 0; k + 1 < run.singles.size(); ++k){
+    
+    muonShowers.setEndTime(run.singles[k].getTriggerTime());
+    for(; itMuon != run.muons.end() && itMuon->getTriggerTime() < run.singles[k].getTriggerTime(); ++itMuon) muonShowers.pushBackEvent(Shower<Muon<T>, Single<T>>(*itMuon, followerTimeBounds));
+    muonShowers.modifyEventsIf([&](const auto& shower){return shower.getFollowerWindow().covers(run.singles[k]);}, [&](auto& shower){shower.pushBackFollower(run.singles[k]);});
+    candidateTrees.emplace_back(CandidatePair<T>(run.singles[k], run.singles[k + 1]), muonShowers);
+    
+  }
+  
+  benchmark("singles", run.singles, numberOfRepetitions);
+  benchmark("muons", run.muons, numberOfRepetitions);
+  benchmark("trees", candidateTrees, numberOfRepetitions);
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  double runDuration = argc > 1 ? std::stod(argv[1]) : 3600;//s of toy run
+  unsigned numberOfRepetitions = argc > 2 ? std::stoul(argv[2]) : 5;
+  
+  benchmark<float>(runDuration, numberOfRepetitions);
+  benchmark<double>(runDuration, numberOfRepetitions);
+  
+}
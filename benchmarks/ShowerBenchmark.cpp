@@ -0,0 +1,73 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "Cosmogenic/Shower.hpp"
+#include "Cosmogenic/ToyGenerator.hpp"
+
+template <class T, class ShowerFactory>
+void benchmark(const std::string& name, const CosmogenicHunter::ToyRun<T,T>& run, CosmogenicHunter::TriggerTime lenght, unsigned numberOfRepetitions, ShowerFactory getShower){
+  
+  CosmogenicHunter::Bounds<CosmogenicHunter::TriggerTime> followerTimeBounds(0, lenght);
+  unsigned long numberOfFollowers = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition){
+    
+    auto itFirstSingle = run.singles.begin();
+    for(const auto& muon : run.muons){
+      
+      auto& shower = getShower(muon, followerTimeBounds);
+      for(; itFirstSingle != run.singles.end() && itFirstSingle->getTriggerTime() < muon.getTriggerTime(); ++itFirstSingle);
+      for(auto itSingle = itFirstSingle; itSingle != run.singles.end() && itSingle->getTriggerTime() < muon.getTriggerTime() + lenght; ++itSingle) shower.pushBackFollower(*itSingle);
+      numberOfFollowers += shower.getNumberOfFollowers();
+      
+    }
+    
+  }
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  
+  std::cout<<"  "<<std::setw(7)<<std::left<<name<<std::setw(8)<<std::right<<lenght * 1e-6<<" ms   "
+    <<std::setw(10)<<std::right<<numberOfFollowers / duration.count() * 1e-6<<" Mfollowers/s   "
+    <<std::setw(10)<<std::right<<numberOfFollowers * sizeof(CosmogenicHunter::Single<T>) / duration.count() * 1e-6<<" MB/s   "
+    <<"followers per muon: "<<static_cast<double>(numberOfFollowers) / (run.muons.size() * numberOfRepetitions)<<"\n";
+  
+}
+
+template <class T>
+void benchmark(double runDuration, double singleRate, unsigned numberOfRepetitions){
+  
+  using namespace CosmogenicHunter;
+  ToyParameters parameters;
+  parameters.accidentalRate = singleRate * 1e-9;
+  auto run = ToyGenerator<T,T>(parameters).generate(runDuration * 1e9, 0);
+  std::cout<<(sizeof(T) == sizeof(float) ? "float" : "double")<<": "<<run.muons.size()<<" muons, "<<run.singles.size()<<" singles\n";
+  
+  for(double lenght : {1e5, 1e6, 1e7, 1e8}){
+    
+    Shower<Muon<T>, Single<T>> shower;
+    benchmark("new", run, lenght, numberOfRepetitions, [&](const Muon<T>& muon, const Bounds<TriggerTime>& followerTimeBounds) -> auto&{
+      
+      shower = Shower<Muon<T>, Single<T>>(muon, followerTimeBounds);
+      return shower;
+      
+    });
+    benchmark("reset", run, lenght, numberOfRepetitions, [&](const Muon<T>& muon, const Bounds<TriggerTime>& followerTimeBounds) -> auto&{//reuses the memory of the follower window
+      
+      shower.reset(muon, followerTimeBounds);
+      return shower;
+      
+    });
+    
+  }
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  double runDuration = argc > 1 ? std::stod(argv[1]) : 600;//s of toy run
+  double singleRate = argc > 2 ? std::stod(argv[2]) : 1e3;//Hz of accidentals
+  unsigned numberOfRepetitions = argc > 3 ? std::stoul(argv[3]) : 5;
+  
+  benchmark<float>(runDuration, singleRate, numberOfRepetitions);
+  benchmark<double>(runDuration, singleRate, numberOfRepetitions);
+  
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "Cosmogenic/ToyGenerator.hpp"
+#include "Cosmogenic/CandidatePair.hpp"
+#include "Cosmogenic/LightNoiseVeto.hpp"
+#include "Cosmogenic/InnerVeto.hpp"
+#include "Cosmogenic/ChimneyVeto.hpp"
+#include "Cosmogenic/ReconstructionVeto.hpp"
+#include "Cosmogenic/BufferMuonVeto.hpp"
+#include "Cosmogenic/AfterMuonVeto.hpp"
+
+template <class T>
+CosmogenicHunter::TriggerTime getTriggerTime(const CosmogenicHunter::Single<T>& single){
+  
+  return single.getTriggerTime();
+  
+}
+
+template <class T>
+CosmogenicHunter::TriggerTime getTriggerTime(const CosmogenicHunter::CandidatePair<T>& candidatePair){
+  
+  return candidatePair.getDelayed().getTriggerTime();
+  
+}
+
+template <class Vetoable, class VetoFunction>
+void benchmark(const std::string& name, const std::string& vetoableName, const std::vector<Vetoable>& vetoables, unsigned numberOfRepetitions, VetoFunction veto){
+  
+  unsigned long numberOfVetoed = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition) numberOfVetoed += veto(vetoables);
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  
+  double numberOfCalls = static_cast<double>(vetoables.size()) * numberOfRepetitions;
+  std::cout<<"  "<<std::setw(20)<<std::left<<name<<std::setw(7)<<std::left<<vetoableName
+    <<std::setw(10)<<std::right<<numberOfCalls / duration.count() * 1e-6<<" Mevents/s   "
+    <<std::setw(10)<<std::right<<numberOfCalls * sizeof(Vetoable) / duration.count() * 1e-6<<" MB/s   "
+    <<"vetoed: "<<numberOfVetoed / numberOfCalls<<"\n";
+  
+}
+
+template <class T, class Vetoable>
+void benchmark(const CosmogenicHunter::Veto<T>& veto, const std::string& vetoableName, const std::vector<Vetoable>& vetoables, unsigned numberOfRepetitions){//through the base class, as VetoSet calls them
+  
+  benchmark(veto.getName(), vetoableName, vetoables, numberOfRepetitions, [&](const auto& vetoables){
+    
+    unsigned long numberOfVetoed = 0;
+    for(const auto& vetoable : vetoables) numberOfVetoed += veto.veto(vetoable);
+    return numberOfVetoed;
+    
+  });
+  
+}
+
+template <class T, class Vetoable>
+void benchmark(const CosmogenicHunter::AfterMuonVeto<T>& prototype, const std::vector<CosmogenicHunter::Muon<T>>& muons, const std::string& vetoableName, const std::vector<Vetoable>& vetoables, unsigned numberOfRepetitions){//muons added in time order between the vetoed events
+  
+  benchmark(prototype.getName(), vetoableName, vetoables, numberOfRepetitions, [&](const auto& vetoables){
+    
+    auto afterMuonVeto = prototype;
+    unsigned long numberOfVetoed = 0;
+    auto itMuon = muons.begin();
+    for(const auto& vetoable : vetoables){
+      
+      auto triggerTime = getTriggerTime(vetoable);
+      for(; itMuon != muons.end() && itMuon->getTriggerTime() <= triggerTime; ++itMuon) afterMuonVeto.addMuon(*itMuon);
+      afterMuonVeto.eraseBefore(triggerTime - prototype.getShoweringMuonVetoTime());
+      numberOfVetoed += afterMuonVeto.veto(vetoable);
+      
+    }
+    return numberOfVetoed;
+    
+  });
+  
+}
+
+template <class T>
+void benchmark(double runDuration, unsigned numberOfRepetitions){
+  
+  using namespace CosmogenicHunter;
+  auto run = ToyGenerator<T,T>().generate(runDuration * 1e9, 0);
+  std::vector<CandidatePair<T>> candidatePairs;
+  for(unsigned k = 0; k + 1 < run.singles.size(); ++k) candidatePairs.emplace_back(run.singles[k], run.singles[k + 1]);
+  std::cout<<(sizeof(T) == sizeof(float) ? "float" : "double")<<": "<<run.muons.size()<<" muons, "<<run.singles.size()<<" singles\n";
+  
+  LightNoiseVeto<T> lightNoiseVeto(464, 8, 3e4, 0.12, 36);
+  InnerVeto<T> innerVeto(400, 2, Bounds<T>(-110, 50), 3700);
+  ChimneyVeto<T> chimneyVeto(1);
+  ReconstructionVeto<T> reconstructionVeto(0.068, 0.88);
+  BufferMuonVeto<T> bufferMuonVeto(0.1, 0.1);
+  AfterMuonVeto<T> afterMuonVeto(1e6, 5e8, 2000, 6e7, 2);
+  for(const Veto<T>* veto : std::initializer_list<const Veto<T>*>{&lightNoiseVeto, &innerVeto, &chimneyVeto, &reconstructionVeto, &bufferMuonVeto}){
+    
+    benchmark(*veto, "single", run.singles, numberOfRepetitions);
+    benchmark(*veto, "pair", candidatePairs, numberOfRepetitions);
+    
+  }
+  benchmark(afterMuonVeto, run.muons, "single", run.singles, numberOfRepetitions);
+  benchmark(afterMuonVeto, run.muons, "pair", candidatePairs, numberOfRepetitions);
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  double runDuration = argc > 1 ? std::stod(argv[1]) : 3600;//s of toy run
+  unsigned numberOfRepetitions = argc > 2 ? std::stoul(argv[2]) : 20;
+  
+  benchmark<float>(runDuration, numberOfRepetitions);
+  benchmark<double>(runDuration, numberOfRepetitions);
+  
+}
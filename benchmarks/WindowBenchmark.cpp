@@ -0,0 +1,56 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "Cosmogenic/Window.hpp"
+#include "Cosmogenic/ToyGenerator.hpp"
+
+template <class Event>
+void benchmark(const std::string& name, const std::vector<Event>& events, CosmogenicHunter::TriggerTime lenght, unsigned numberOfRepetitions){
+  
+  double totalNumberOfEvents = 0;//summed over the pushes, so that the loop is not optimised away
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned repetition = 0; repetition < numberOfRepetitions; ++repetition){
+    
+    CosmogenicHunter::Window<Event> window(events.front().getTriggerTime(), lenght);
+    for(const auto& event : events){
+      
+      window.setEndTime(event.getTriggerTime() + 1);//slides as the muon window of OnlineTreeBuilder
+      window.pushBackEvent(event);
+      totalNumberOfEvents += window.getNumberOfEvents();
+      
+    }
+    
+  }
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  
+  double numberOfPushes = static_cast<double>(events.size()) * numberOfRepetitions;
+  std::cout<<std::setw(9)<<std::left<<name<<std::setw(8)<<std::right<<lenght * 1e-6<<" ms   "
+    <<std::setw(10)<<std::right<<numberOfPushes / duration.count() * 1e-6<<" Mevents/s   "
+    <<std::setw(10)<<std::right<<numberOfPushes * sizeof(Event) / duration.count() * 1e-6<<" MB/s   "
+    <<"mean size: "<<totalNumberOfEvents / numberOfPushes<<"\n";
+  
+}
+
+template <class T>
+void benchmark(double runDuration, unsigned numberOfRepetitions){
+  
+  auto run = CosmogenicHunter::ToyGenerator<T,T>().generate(runDuration * 1e9, 0);
+  std::cout<<(sizeof(T) == sizeof(float) ? "float" : "double")<<": "<<run.muons.size()<<" muons, "<<run.singles.size()<<" singles\n";
+  for(double lenght : {1e6, 1e7, 1e8, 1e9, 1e10}){
+    
+    benchmark("  singles", run.singles, lenght, numberOfRepetitions);
+    benchmark("  muons", run.muons, lenght, numberOfRepetitions);
+    
+  }
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  double runDuration = argc > 1 ? std::stod(argv[1]) : 3600;//s of toy run
+  unsigned numberOfRepetitions = argc > 2 ? std::stoul(argv[2]) : 5;
+  
+  benchmark<float>(runDuration, numberOfRepetitions);
+  benchmark<double>(runDuration, numberOfRepetitions);
+  
+}
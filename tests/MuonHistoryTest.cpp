@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include "Cosmogenic/MuonHistory.hpp"
+
+//exits with 1 if any check fails, the failed checks are printed
+namespace{
+  
+  unsigned numberOfFailures = 0;
+  
+  void check(bool condition, const std::string& description){
+    
+    if(!condition){
+      
+      std::cerr<<"FAILED: "<<description<<"\n";
+      ++numberOfFailures;
+      
+    }
+    
+  }
+  
+  template <class T>
+  CosmogenicHunter::Muon<T> makeMuon(CosmogenicHunter::TriggerTime triggerTime, unsigned identifier, T visibleEnergy, T trackX){
+    
+    using namespace CosmogenicHunter;
+    return Muon<T>(triggerTime, visibleEnergy, identifier, Segment<T>(Point<T>(trackX, 0, 5000), Point<T>(trackX, 0, -5000)), 0, visibleEnergy);
+    
+  }
+  
+  template <class T>
+  void testErasedMuonsAreNotFound(){
+    
+    using namespace CosmogenicHunter;
+    MuonHistory<T> muonHistory;
+    muonHistory.pushBackMuon(makeMuon<T>(10, 1, 500, 0));//track through the origin
+    muonHistory.pushBackMuon(makeMuon<T>(20, 2, 500, 1000));//far track
+    muonHistory.eraseBefore(15);
+    
+    check(muonHistory.getNumberOfMuons() == 1, "one muon left after eraseBefore");
+    check(muonHistory.getLastMuonBefore(30, Point<T>(0, 0, 0), 10) == nullptr, "distance query skips the erased muon");
+    check(muonHistory.getLastMuonBefore(30, std::numeric_limits<T>::lowest()) != nullptr && muonHistory.getLastMuonBefore(30, std::numeric_limits<T>::lowest())->getIdentifier() == 2, "lowest() energy query finds the live muon");
+    check(muonHistory.getLastMuonBefore(15, std::numeric_limits<T>::lowest()) == nullptr, "lowest() energy query before the live muon finds nothing");
+    check(muonHistory.getLastMuonBefore(30, Point<T>(1000, 0, 0), 10) != nullptr, "distance query finds the live muon");
+    
+  }
+  
+  template <class T>
+  void testAgainstLinearScan(){//erases, compactions and growth against the scan of the live muons
+    
+    using namespace CosmogenicHunter;
+    MuonHistory<T> muonHistory;
+    TriggerTime erasedBefore = 0;
+    unsigned identifier = 0;
+    for(TriggerTime time = 0; time < 20000; time += 7){
+      
+      muonHistory.pushBackMuon(makeMuon<T>(time, identifier, static_cast<T>((identifier * 37) % 101), static_cast<T>((identifier * 53) % 200)));
+      ++identifier;
+      if(identifier % 50 == 0){
+        
+        erasedBefore = time - 300;
+        muonHistory.eraseBefore(erasedBefore);
+        
+      }
+      
+      for(T minVisibleEnergy : {std::numeric_limits<T>::lowest(), T(50), T(99)}){
+        
+        const Muon<T>* expected = nullptr;
+        const Muon<T>* expectedNear = nullptr;
+        for(const auto& muon : muonHistory){
+          
+          if(muon.getTriggerTime() >= time - 100 || muon.template Event<T>::getVisibleEnergy() < minVisibleEnergy) continue;
+          expected = &muon;
+          if(muon.getTrack().getDistanceTo(Point<T>(0, 0, 0)) < 20) expectedNear = &muon;
+          
+        }
+        check(muonHistory.getLastMuonBefore(time - 100, minVisibleEnergy) == expected, "energy query at "+std::to_string(time));
+        check(muonHistory.getLastMuonBefore(time - 100, Point<T>(0, 0, 0), 20, minVisibleEnergy) == expectedNear, "distance query at "+std::to_string(time));
+        
+      }
+      
+    }
+    
+  }
+  
+}
+
+int main(){
+  
+  testErasedMuonsAreNotFound<float>();
+  testErasedMuonsAreNotFound<double>();
+  testAgainstLinearScan<float>();
+  testAgainstLinearScan<double>();
+  
+  if(numberOfFailures == 0) std::cout<<"MuonHistory: all checks passed\n";
+  return numberOfFailures == 0 ? 0 : 1;
+  
+}
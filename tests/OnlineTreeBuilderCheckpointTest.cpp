@@ -0,0 +1,154 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "Cosmogenic/ToyGenerator.hpp"
+#include "Cosmogenic/OnlineTreeBuilder.hpp"
+#include "Cosmogenic/EventStream.hpp"
+#include "Cosmogenic/Checkpoint.hpp"
+
+//exits with 1 if any check fails, the failed checks are printed
+namespace{
+
+  unsigned numberOfFailures = 0;
+
+  void check(bool condition, const std::string& description){
+
+    if(!condition){
+
+      std::cerr<<"FAILED: "<<description<<"\n";
+      ++numberOfFailures;
+
+    }
+
+  }
+
+  template <class Event>
+  CosmogenicHunter::EventStream<Event> makeStream(const std::vector<Event>& events){//as if read from a file, small batches so that the checkpoint falls in the middle of the buffers
+
+    return CosmogenicHunter::EventStream<Event>([&events, k = std::size_t(0)](Event& event) mutable{
+
+      if(k == events.size()) return false;
+      event = events[k++];
+      return true;
+
+    }, 0, 64);
+
+  }
+
+  template <class T>
+  CosmogenicHunter::OnlineTreeBuilder<T,T> makeTreeBuilder(std::vector<std::string>& trees){//emits the trees serialized, to compare them byte for byte
+
+    using namespace CosmogenicHunter;
+    return OnlineTreeBuilder<T,T>(1e9, Bounds<TriggerTime>(0, 1e6), Bounds<TriggerTime>(500, 150e3), [&trees](CandidateTree<T,T> candidateTree){
+
+      std::ostringstream stream;
+      {
+
+        cereal::BinaryOutputArchive archive(stream);
+        archive(candidateTree);
+
+      }
+      trees.push_back(stream.str());
+
+    }, [](const CandidatePair<T>& candidatePair){
+
+      return candidatePair.isSpaceCorrelated(1000);
+
+    });
+
+  }
+
+  template <class T>
+  unsigned long long feed(CosmogenicHunter::OnlineTreeBuilder<T,T>& treeBuilder, CosmogenicHunter::EventStream<CosmogenicHunter::Muon<T>>& muons, CosmogenicHunter::EventStream<CosmogenicHunter::Single<T>>& singles, unsigned long long numberOfEvents){//in time order, returns the number of events fed
+
+    unsigned long long numberOfFedEvents = 0;
+    for(; numberOfFedEvents < numberOfEvents && (!muons.isEmpty() || !singles.isEmpty()); ++numberOfFedEvents){//the identifiers give the time order of both streams
+
+      if(singles.isEmpty() || (!muons.isEmpty() && muons.front().getIdentifier() < singles.front().getIdentifier())) treeBuilder.pushMuon(muons.popFront());
+      else treeBuilder.pushSingle(singles.popFront());
+
+    }
+    return numberOfFedEvents;
+
+  }
+
+  template <class T>
+  void testResumedRunMatchesUninterruptedRun(){
+
+    using namespace CosmogenicHunter;
+    ToyParameters parameters;
+    parameters.ibdRate = 1e-9;//pairs in every muon window
+    auto run = ToyGenerator<T,T>(parameters, 1e9, 1).generate(60e9, 0);
+    auto numberOfEvents = run.muons.size() + run.singles.size();
+
+    std::vector<std::string> uninterruptedTrees;
+    {
+
+      auto treeBuilder = makeTreeBuilder<T>(uninterruptedTrees);
+      auto muons = makeStream(run.muons);
+      auto singles = makeStream(run.singles);
+      feed(treeBuilder, muons, singles, numberOfEvents);
+      treeBuilder.flush();
+
+    }
+
+    auto checkpointPath = (std::filesystem::temp_directory_path() / ("OnlineTreeBuilderCheckpointTest" + std::to_string(sizeof(T)) + ".checkpoint")).string();
+    std::filesystem::remove(checkpointPath);
+    std::vector<std::string> resumedTrees;
+    unsigned long long numberOfTreesBeforeCheckpoint;
+    {//pre-empted midway
+
+      auto treeBuilder = makeTreeBuilder<T>(resumedTrees);
+      auto muons = makeStream(run.muons);
+      auto singles = makeStream(run.singles);
+      feed(treeBuilder, muons, singles, numberOfEvents / 2);
+      check(treeBuilder.getNumberOfBufferedMuons() + treeBuilder.getNumberOfBufferedSingles() > 0, "the checkpoint holds pending events");
+
+      Checkpoint checkpoint(checkpointPath);
+      checkpoint.save("treeBuilder", treeBuilder);
+      checkpoint.save("muonOffset", muons.getNumberOfPoppedEvents());
+      checkpoint.save("singleOffset", singles.getNumberOfPoppedEvents());
+      checkpoint.commit();
+      checkpoint.wait();
+      numberOfTreesBeforeCheckpoint = resumedTrees.size();
+
+    }
+    {//resumed by a fresh job
+
+      auto treeBuilder = makeTreeBuilder<T>(resumedTrees);
+      auto muons = makeStream(run.muons);
+      auto singles = makeStream(run.singles);
+      unsigned long long muonOffset = 0, singleOffset = 0;
+
+      Checkpoint checkpoint(checkpointPath);
+      check(checkpoint.restore("treeBuilder", treeBuilder) && checkpoint.restore("muonOffset", muonOffset) && checkpoint.restore("singleOffset", singleOffset), "all the sections are restored");
+      check(treeBuilder.getNumberOfEmittedTrees() == numberOfTreesBeforeCheckpoint, "the emitted tree count is restored");
+      muons.skip(muonOffset);
+      singles.skip(singleOffset);
+      check(feed(treeBuilder, muons, singles, numberOfEvents) == numberOfEvents - muonOffset - singleOffset, "the streams resume after the checkpointed events");
+      treeBuilder.flush();
+      checkpoint.remove();
+
+    }
+
+    check(!uninterruptedTrees.empty(), "the run emits trees");
+    check(numberOfTreesBeforeCheckpoint > 0 && numberOfTreesBeforeCheckpoint < uninterruptedTrees.size(), "the checkpoint falls between emitted trees");
+    check(resumedTrees.size() == uninterruptedTrees.size(), "resumed run emits "+std::to_string(resumedTrees.size())+" trees, uninterrupted run "+std::to_string(uninterruptedTrees.size()));
+    check(resumedTrees == uninterruptedTrees, "resumed run emits the trees of the uninterrupted run");
+    check(!std::filesystem::exists(checkpointPath), "the checkpoint is removed");
+
+  }
+
+}
+
+int main(){
+
+  testResumedRunMatchesUninterruptedRun<float>();
+  testResumedRunMatchesUninterruptedRun<double>();
+
+  if(numberOfFailures == 0) std::cout<<"OnlineTreeBuilderCheckpoint: all checks passed\n";
+  return numberOfFailures == 0 ? 0 : 1;
+
+}
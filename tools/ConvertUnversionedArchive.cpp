@@ -0,0 +1,76 @@
+#include <iostream>
+#include <fstream>
+#include "cereal/archives/binary.hpp"
+#include "cereal/types/vector.hpp"
+#include "Cosmogenic/CandidateTree.hpp"
+
+//rewrites an archive written before the classes were versioned as a versioned one, so that it is converted once instead of reprocessing the run
+template <class Class>
+unsigned long convert(std::istream& input, std::ostream& output, bool isVector){//returns the number of objects converted
+  
+  cereal::BinaryInputArchive inputArchive(input);
+  cereal::BinaryOutputArchive outputArchive(output);
+  unsigned long numberOfObjects = 0;
+  while(input.peek() != std::char_traits<char>::eof()){//the top level objects (or vectors) follow each other until the end of the archive
+    
+    if(isVector){
+      
+      std::vector<Class> objects;
+      CosmogenicHunter::loadUnversioned(inputArchive, objects);
+      outputArchive(objects);
+      numberOfObjects += objects.size();
+      
+    }
+    else{
+      
+      Class object;
+      CosmogenicHunter::loadUnversioned(inputArchive, object);
+      outputArchive(object);
+      ++numberOfObjects;
+      
+    }
+    
+  }
+  
+  return numberOfObjects;
+  
+}
+
+template <class T>
+unsigned long convert(const std::string& className, std::istream& input, std::ostream& output, bool isVector){
+  
+  using namespace CosmogenicHunter;
+  if(className == "single") return convert<Single<T>>(input, output, isVector);
+  else if(className == "muon") return convert<Muon<T>>(input, output, isVector);
+  else if(className == "candidatePair") return convert<CandidatePair<T>>(input, output, isVector);
+  else if(className == "candidateTree") return convert<CandidateTree<T,T>>(input, output, isVector);
+  else throw std::invalid_argument(className+" is not a valid class, use single, muon, candidatePair or candidateTree.");
+  
+}
+
+int main(int argc, char* argv[]){
+  
+  if(argc < 5){
+    
+    std::cerr<<"Usage: "<<argv[0]<<" <single|muon|candidatePair|candidateTree> <float|double> <unversioned archive> <versioned archive> [vector]\n"
+      <<"The archive holds one object after the other, or std::vector's of them with 'vector'.\n";
+    return 1;
+    
+  }
+  std::string className = argv[1];
+  std::string precision = argv[2];
+  bool isVector = argc > 5 && std::string(argv[5]) == "vector";
+  
+  std::ifstream input(argv[3], std::ios::binary);
+  if(!input) throw std::runtime_error("Cannot read "+std::string(argv[3])+".");
+  std::ofstream output(argv[4], std::ios::binary);
+  if(!output) throw std::runtime_error("Cannot write "+std::string(argv[4])+".");
+  
+  unsigned long numberOfObjects = 0;
+  if(precision == "float") numberOfObjects = convert<float>(className, input, output, isVector);
+  else if(precision == "double") numberOfObjects = convert<double>(className, input, output, isVector);
+  else throw std::invalid_argument(precision+" is not a valid precision, use float or double.");
+  
+  std::cout<<numberOfObjects<<" "<<className<<" converted to "<<argv[4]<<"\n";
+  
+}